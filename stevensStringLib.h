@@ -34,10 +34,95 @@
 #include<charconv>
 #include<map>
 #include<unordered_map>
+#include<string_view>
+#include<cstdint>
+#include<cstring>
+#include<bit>
+#include<span>
+#include<compare>
+#include<iterator>
+#include<thread>
+#include<exception>
+#include<concepts>
+#include<optional>
+#include<array>
+#include<atomic>
+
+//SIMD code paths are compiled with function-level target attributes and selected at runtime, so the library
+//still builds without any -m flags. Other compilers and architectures use the scalar code only.
+#if defined(__GNUC__) && defined(__x86_64__)
+#define STEVENSSTRINGLIB_X86_64
+#include<immintrin.h>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#define STEVENSSTRINGLIB_POSIX
+#include<fcntl.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+#include<unistd.h>
+#endif
 
 
 namespace stevensStringLib
 {
+    namespace detail
+    {
+        /**
+         * Returns true if the CPU running the program supports AVX2. The answer is computed once and cached.
+         */
+        bool cpuHasAvx2()
+        {
+#ifdef STEVENSSTRINGLIB_X86_64
+            static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+            return hasAvx2;
+#else
+            return false;
+#endif
+        }
+
+
+        /**
+         * Loads 8 bytes from memory into an integer, without any alignment requirement.
+         */
+        std::uint64_t load64( const void * p )
+        {
+            std::uint64_t word;
+            std::memcpy(&word, p, sizeof(word));
+            return word;
+        }
+
+
+        /**
+         * ASCII byte classification tables: for each byte, its lowercase version, whether it is a letter or digit, and
+         * whether it is whitespace (space, \t, \n, \v, \f or \r). Bytes above 0x7F are neither.
+         */
+        struct CharClassTable
+        {
+            unsigned char lower[256];
+            bool alphanumeric[256];
+            bool whitespace[256];
+        };
+
+        constexpr CharClassTable makeCharClassTable()
+        {
+            CharClassTable table = {};
+            for(int c = 0; c < 256; ++c)
+            {
+                const bool upper = (c >= 'A') && (c <= 'Z');
+                const bool lower = (c >= 'a') && (c <= 'z');
+                const bool digit = (c >= '0') && (c <= '9');
+                table.lower[c] = static_cast<unsigned char>(upper ? c - 'A' + 'a' : c);
+                table.alphanumeric[c] = upper || lower || digit;
+                table.whitespace[c] = (c == ' ') || ((c >= '\t') && (c <= '\r'));
+            }
+            return table;
+        }
+
+        constexpr CharClassTable charClassTable = makeCharClassTable();
+    }
+
+
     // JJO: This is where the required C++ version for your lib is important. If
     // you require C++23 as suggested by the comment in the test file, then this
     // function is useless; the caller should use str.contains(substring). If it
@@ -253,62 +338,185 @@ namespace stevensStringLib
     }
 
 
-    /**
-     * Detects if a string is in the form of a valid C++ integer.
-     *
-     * @param str - A string we are checking to see if it represents an integer.
-     *
-     * @retval bool - true if the string str represents an integer, false otherwise.
-    */
-    bool isInteger( const std::string & str )
+    namespace detail
     {
-        for (int charIndex = 0; charIndex < str.length(); charIndex++)
+        constexpr std::array<unsigned char, 256> makeDigitValueTable()
         {
-            //The first index has the possibility of having a negative sign
-            if(charIndex == 0)
+            std::array<unsigned char, 256> table{};
+            for(unsigned c = 0; c < 256; ++c)
             {
-                if(str[charIndex] == '-')
+                table[c] = 0xFF;
+                if((c >= '0') && (c <= '9'))
                 {
-                    continue;
+                    table[c] = c - '0';
+                }
+                else if((c >= 'a') && (c <= 'z'))
+                {
+                    table[c] = c - 'a' + 10;
+                }
+                else if((c >= 'A') && (c <= 'Z'))
+                {
+                    table[c] = c - 'A' + 10;
                 }
             }
-            //Check to see if the character is a numerical digit
-            if (!isdigit(str[charIndex]))
+            return table;
+        }
+
+        //The value of each character as a digit in bases up to 36, or 0xFF for characters that are not digits
+        constexpr std::array<unsigned char, 256> digitValueTable = makeDigitValueTable();
+
+
+        /**
+         * Accumulates the digits of a string into magnitude, checking on each digit that the result stays within
+         * limit. The check uses the strtol cutoff: value * base + digit exceeds limit exactly when value is past
+         * limit / base, or equal to it with digit past limit % base. With StaticBase non-zero the base is a constant,
+         * so the division and multiplication become cheap shifts and multiplications.
+         *
+         * A separator may appear between two digits. Returns false if the string holds anything else, or no digits,
+         * or overflows.
+         */
+        template<typename U, unsigned StaticBase>
+        bool accumulateDigits(  std::string_view digits,
+                                unsigned runtimeBase,
+                                char separator,
+                                U limit,
+                                U & magnitude   )
+        {
+            const unsigned base = (StaticBase != 0) ? StaticBase : runtimeBase;
+            const U cutoff = limit / base;
+            const unsigned cutoffDigit = static_cast<unsigned>(limit % base);
+            U value = 0;
+            bool previousWasDigit = false;
+            for(char c : digits)
             {
-                return false;
+                if((c == separator) && (separator != '\0'))
+                {
+                    if(!previousWasDigit)
+                    {
+                        return false;
+                    }
+                    previousWasDigit = false;
+                    continue;
+                }
+                const unsigned digit = digitValueTable[static_cast<unsigned char>(c)];
+                if(digit >= base)
+                {
+                    return false;
+                }
+                if((value > cutoff) || ((value == cutoff) && (digit > cutoffDigit)))
+                {
+                    return false;
+                }
+                value = static_cast<U>(value * base + digit);
+                previousWasDigit = true;
             }
+            magnitude = value;
+            return previousWasDigit;
         }
+    }
 
-        //Now that we're sure we have a string that contains only digits and possibly a negative sign, we check
-        //to see if converting the string to an integer will cause errors
 
-        // JJO: This initialization is useless, std::from_chars will overwrite
-        // it on success, and it does not matter on error.
-        int value = 0;
-        // JJO: What is the point of the loop above if you call std::from_chars?
-        // The latter will do the check done in this loop.
-        const auto res = std::from_chars(   str.data(),
-                                            str.data() + str.size(),
-                                            value );
-        if (res.ec == std::errc::invalid_argument)
+    /**
+     * Parses a string as an integer of type T, checking that it fits in T in the same pass as the validation. The
+     * string is an optional '+' or '-' sign followed by digits in the given base, with nothing else around them. In
+     * base 16 the digits may be preceded by "0x" or "0X". If digitSeparator is not '\0', it may appear between two
+     * digits, e.g. "1'000'000". T is any integer type but bool.
+     *
+     * Throws std::invalid_argument if base is not between 2 and 36, or if digitSeparator is a digit in that base.
+     *
+     * @param str - The string to parse.
+     * @param base - The base of the digits, from 2 to 36. Letters are digits past 9, in either case.
+     * @param digitSeparator - A character allowed between digits, or '\0' for none.
+     *
+     * @retval std::optional<T> - The value of the string, or std::nullopt if it is not an integer or does not fit in T.
+     */
+    template<std::integral T = int>
+    requires (!std::same_as<T, bool>)
+    std::optional<T> parseInteger(  std::string_view str,
+                                    int base = 10,
+                                    char digitSeparator = '\0'    )
+    {
+        if((base < 2) || (base > 36))
+        {
+            throw std::invalid_argument("parseInteger(): the base must be between 2 and 36, got " + std::to_string(base));
+        }
+        if((digitSeparator != '\0') && (detail::digitValueTable[static_cast<unsigned char>(digitSeparator)] < base))
         {
-            // JJO: This comment adds nothing that is not already said by the
-            // condition above.
+            throw std::invalid_argument("parseInteger(): the digit separator cannot be a digit");
+        }
 
-            //Invalid argument for std::from_chars()
-            return false;
+        using U = std::make_unsigned_t<T>;
+        bool negative = false;
+        if(!str.empty() && ((str.front() == '-') || (str.front() == '+')))
+        {
+            negative = (str.front() == '-');
+            str.remove_prefix(1);
         }
-        else if (res.ec == std::errc::result_out_of_range)
+        if(negative && std::is_unsigned_v<T>)
+        {
+            return std::nullopt;
+        }
+        if((base == 16) && (str.size() > 2) && (str[0] == '0') && ((str[1] == 'x') || (str[1] == 'X')))
         {
-            // JJO: Same, this comment adds nothing that is not already said by
-            // the condition above.
+            str.remove_prefix(2);
+        }
 
-            //Overflow/underflow has occurred
-            return false;
+        //The magnitude of the most negative value is one past the maximum
+        const U limit = static_cast<U>(static_cast<U>(std::numeric_limits<T>::max()) + negative);
+        U magnitude = 0;
+        bool valid = false;
+        if(base == 10)
+        {
+            valid = detail::accumulateDigits<U, 10>(str, 10, digitSeparator, limit, magnitude);
+        }
+        else if(base == 16)
+        {
+            valid = detail::accumulateDigits<U, 16>(str, 16, digitSeparator, limit, magnitude);
         }
+        else
+        {
+            valid = detail::accumulateDigits<U, 0>(str, base, digitSeparator, limit, magnitude);
+        }
+        if(!valid)
+        {
+            return std::nullopt;
+        }
+        return negative ? static_cast<T>(static_cast<U>(0 - magnitude)) : static_cast<T>(magnitude);
+    }
 
-        //Otherwise, return true
-        return true;
+
+    /**
+     * Detects if a string represents an integer that fits in type T, e.g. isInteger<std::int64_t>("3000000000") is
+     * true while isInteger<int>("3000000000") is false. The accepted syntax is that of parseInteger().
+     *
+     * Throws std::invalid_argument if base is not between 2 and 36, or if digitSeparator is a digit in that base.
+     *
+     * @param str - A string we are checking to see if it represents an integer.
+     * @param base - The base of the digits, from 2 to 36.
+     * @param digitSeparator - A character allowed between digits, or '\0' for none.
+     *
+     * @retval bool - true if the string str represents an integer that fits in T, false otherwise.
+     */
+    template<std::integral T = int>
+    requires (!std::same_as<T, bool>)
+    bool isInteger(     std::string_view str,
+                        int base = 10,
+                        char digitSeparator = '\0'    )
+    {
+        return parseInteger<T>(str, base, digitSeparator).has_value();
+    }
+
+
+    /**
+     * Detects if a string is in the form of a valid C++ integer that fits in an int.
+     *
+     * @param str - A string we are checking to see if it represents an integer.
+     *
+     * @retval bool - true if the string str represents an integer, false otherwise.
+    */
+    bool isInteger( const std::string & str )
+    {
+        return isInteger<int>(std::string_view(str));
     }
 
 
@@ -825,23 +1033,20 @@ namespace stevensStringLib
 
 
     /**
-     * JJO: an an -> and an.
-     *
-     * Given a string an an integer representing an index, return a single character from the string by the process of circular
+     * Given a string and an integer representing an index, return a single character from the string by the process of circular
      * indexing.
      *
      * Circular indexing is performed by indexing over the string from left to right. Once the index exceeds the length of the string, we begin
      * indexing again from the lefthand side of the string and repeat the process until we stop at the final index. We return the character at
-     * that final index.
+     * that final index. Negative indices count backwards from the end of the string, so -1 is the last character.
      *
      * Example: circularIndex("Hello world!", 13) returns 'e', as we loop around to 'H' at 12 and index one space further to reach 'e'.
      *
-     * JJO: The parameters are already listed in the signature, no need to list
-     * them again in a comment. Or else put a descriptive comment :)
+     * Throws std::invalid_argument if str is empty. For many lookups into the same string, CircularIndexer avoids the division.
      *
      * Parameters:
-     *  std::string str
-     *  int circ_i
+     *  std::string_view str - The string to index into. It is not copied.
+     *  std::ptrdiff_t circ_i - The index, which may be negative or larger than the string.
      *
      * Returns:
      *  char - A character found in str that has been circularly indexed to at position circ_i
@@ -849,217 +1054,8594 @@ namespace stevensStringLib
      *
      * TODO: Create aliases ci and circ_i
     */
-    char circularIndex( std::string str,
-                        int circ_i )
+    char circularIndex( std::string_view str,
+                        std::ptrdiff_t circ_i )
     {
-        //If we have an empty string, we can't index to anything
-        // JJO: Yes, the program will crash with an empty string. Also, what if
-        // circ_i is negative?
-        // if(str.empty())
-        // {
-        //     throw std::invalid_argument("str cannot be empty for circularIndex()");
-        // }
+        if(str.empty())
+        {
+            throw std::invalid_argument("str cannot be empty for circularIndex()");
+        }
 
-        return str[circ_i % str.length()];
+        const std::ptrdiff_t length = str.size();
+        std::ptrdiff_t remainder = circ_i % length;
+        //The remainder has the sign of circ_i: add the length when it is negative, without branching
+        remainder += length & (remainder >> (std::numeric_limits<std::ptrdiff_t>::digits));
+        return str[remainder];
     }
 
 
     /**
-     * Given a string str, erase the last n characters of the string.
-     *
-     * Taken from: https://thispointer.com/remove-last-n-characters-from-a-string-in-c/
-     *
-     * Parameters:
-     *  std::string str - The string we want to erase characters from the end of.
-     *  int n - The number of characters we want to erase
+     * Circular indexing into a string that is indexed many times, e.g. by a pattern generator. The modulo by the string
+     * length is computed with a precomputed 64-bit reciprocal (Lemire's "fastmod"), which replaces the division by two
+     * multiplications for indices in [-2^32, 2^32). Other indices fall back to circularIndex().
      *
-     * Returns:
-     *  std::string - The string str having n characters erased from the end of it.
-    */
-    std::string eraseCharsFromEnd(  std::string str,
-                                    int n   )
+     * The indexer keeps a view of the string, which must outlive it.
+     */
+    class CircularIndexer
     {
-        //Can't erase from empty string
-        // JJO: This should be if (str.size() >= n)
-        if(str.empty())
+    public:
+        /**
+         * Throws std::invalid_argument if str is empty or longer than 2^32 - 1 characters.
+         */
+        explicit CircularIndexer( std::string_view str )
+            : m_str(str)
         {
-            return "";
+            if(str.empty() || (str.size() > std::numeric_limits<std::uint32_t>::max()))
+            {
+                throw std::invalid_argument("CircularIndexer: the string length must be in [1, 2^32)");
+            }
+            m_length = static_cast<std::uint32_t>(str.size());
+            m_reciprocal = std::numeric_limits<std::uint64_t>::max() / m_length + 1;
         }
 
-        str.erase(str.size() - n);
-        return str;
-    }
+        std::size_t size() const
+        {
+            return m_length;
+        }
 
+        /**
+         * Same result as circularIndex(str, circ_i).
+         */
+        char operator[]( std::int64_t circ_i ) const
+        {
+            return m_str[position(circ_i)];
+        }
 
-    /**
-     * Given a string str, find all occurrences of a substring within it. Returns a vector of all of the indices that the substring
-     * occurs at within the string str.
-     *
-     * Based off of: https://stackoverflow.com/a/4034809
-     *
-     * Parameters:
-     *  std::string str - The string we are searching for the substring in.
-     *  std::string substr - The substring we are looking for within string str.
-     *
-     * Returns:
-     *  std::vector<size_t> - A vector containing all indices in increasing order that the substr occurs at.
-    */
-    std::vector<size_t> findAll(    std::string str,
-                                    std::string substr  )
-    {
-        std::vector<size_t> positions;
+        /**
+         * Gathers the characters at many circular indices: out[k] = (*this)[indices[k]]. Throws std::invalid_argument if
+         * out is smaller than indices.
+         */
+        void gather(    std::span<const std::int64_t> indices,
+                        std::span<char> out  ) const
+        {
+            if(out.size() < indices.size())
+            {
+                throw std::invalid_argument("CircularIndexer::gather(): the output is smaller than the indices");
+            }
+            const char * const data = m_str.data();
+            for(std::size_t k = 0; k < indices.size(); ++k)
+            {
+                out[k] = data[position(indices[k])];
+            }
+        }
 
-        size_t pos = str.find(substr, 0);
-        while(pos != std::string::npos)
+        /**
+         * Copies out.size() consecutive characters starting at circular index start, wrapping around the end of the
+         * string as many times as needed. The string is copied in whole runs rather than character by character.
+         */
+        void copy(  std::int64_t start,
+                    std::span<char> out ) const
         {
-            positions.push_back(pos);
-            pos = str.find(substr,pos+1);
+            std::size_t from = position(start);
+            std::size_t written = 0;
+            while(written < out.size())
+            {
+                const std::size_t run = std::min<std::size_t>(m_length - from, out.size() - written);
+                std::memcpy(out.data() + written, m_str.data() + from, run);
+                written += run;
+                from = 0;
+            }
         }
 
-        return positions;
-    }
+    private:
+        /**
+         * Returns circ_i modulo the length of the string, in [0, length).
+         */
+        std::size_t position( std::int64_t circ_i ) const
+        {
+#ifdef __SIZEOF_INT128__
+            constexpr std::int64_t limit = std::int64_t(1) << 32;
+            if((circ_i >= 0) && (circ_i < limit))
+            {
+                return fastModulo(static_cast<std::uint32_t>(circ_i));
+            }
+            if((circ_i < 0) && (circ_i >= -limit + 1))
+            {
+                //-circ_i fits in 32 bits; a remainder r of the magnitude maps to length - r, and 0 stays 0
+                const std::uint32_t remainder = fastModulo(static_cast<std::uint32_t>(-circ_i));
+                return (m_length - remainder) & -std::uint32_t(remainder != 0);
+            }
+#endif
+            const std::int64_t length = m_length;
+            std::int64_t remainder = circ_i % length;
+            remainder += length & (remainder >> 63);
+            return remainder;
+        }
+
+#ifdef __SIZEOF_INT128__
+        std::uint32_t fastModulo( std::uint32_t value ) const
+        {
+            const std::uint64_t lowBits = m_reciprocal * value;
+            return static_cast<std::uint32_t>((static_cast<unsigned __int128>(lowBits) * m_length) >> 64);
+        }
+#endif
+
+        std::string_view m_str;
+        std::uint64_t m_reciprocal;
+        std::uint32_t m_length;
+    };
 
 
     /**
-     * Given a locale, return all of the whitespace characters for that locale in a string.
+     * Gathers the characters of a string at many circular indices at once. See circularIndex() for the indexing rules.
      *
-     * Credit: https://stackoverflow.com/a/36311304/16511184
+     * Throws std::invalid_argument if str is empty or longer than 2^32 - 1 characters.
      *
-     * Parameter:
-     *  const std::locale & loc - The locale which we want to obtain a string of all whitespace characters for.
+     * @param str - The string to index into.
+     * @param indices - The circular indices to read, possibly negative.
      *
-     * Returns:
-     *  std::string - A string of all whitespace characters defined in the given locale.
-    */
-    std::string getWhitespaceString(const std::locale & loc)
+     * @retval std::string - The characters found at each index, in the order of indices.
+     */
+    std::string circularGather( std::string_view str,
+                                std::span<const std::int64_t> indices   )
     {
-        std::string whitespace;
-        for (char ch = std::numeric_limits<char>::min(); ch < std::numeric_limits<char>::max(); ch++)
-            if (std::isspace(ch, loc))
-                whitespace += ch;
-        // to avoid infinte loop check char max outside the for loop.
-        if (std::isspace(std::numeric_limits<char>::max(), std::locale(loc)))
-            whitespace += std::numeric_limits<char>::max();
-        return whitespace;
+        const CircularIndexer indexer(str);
+        std::string result(indices.size(), '\0');
+        indexer.gather(indices, result);
+        return result;
     }
 
 
     /**
-     * Remove all leading and trailing whitespace from a string (spaces, tabs, newlines, etc.), then return it.
-     *
-     * Based on: https://stackoverflow.com/a/1798170
+     * A rotated view of a string: the characters of str read from position rotation to the end, then from the
+     * beginning. Nothing is copied, so the string must outlive the view. CyclicView is the building block for rotating
+     * and comparing cyclic strings (necklaces) without materialising the rotated copies.
      *
-     * Parameter:
-     *  std::string str - The string to remove all of the leading and trailing whitespaces from.
-     *
-     * Returns:
-     *  std::string - str modified by removing all of its leading and trailing whitespaces.
-    */
-    std::string trimWhitespace( std::string str )
+     * Example: CyclicView("hello", 2) reads "llohe".
+     */
+    class CyclicView
     {
-        //Get a string of all of the whitespace characters in the current locale
-        std::string whitespace = getWhitespaceString(std::locale(""));
-
-        const auto strBegin = str.find_first_not_of(whitespace);
-        if (strBegin == std::string::npos)
+    public:
+        /**
+         * Random access iterator over the characters of a CyclicView.
+         */
+        class iterator
         {
-            return ""; // no content
-        }
-
-        const auto strEnd = str.find_last_not_of(whitespace);
-        const auto strRange = strEnd - strBegin + 1;
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = char;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const char *;
+            using reference = char;
 
-        return str.substr(strBegin, strRange);
-    }
+            iterator() = default;
 
+            iterator(   const CyclicView * view,
+                        std::size_t index   )
+                : m_view(view),
+                  m_index(index)
+            {
+            }
 
-    //trimAllOf
+            char operator*() const
+            {
+                return (*m_view)[m_index];
+            }
 
+            char operator[]( difference_type offset ) const
+            {
+                return (*m_view)[m_index + offset];
+            }
 
-    /**
-     * Given a character c, convert it to a std::string.
-     *
-     * Parameter:
-     *  char c - The character we'd like to convert to a string.
-     *
-     * Returns:
-     *  std::string - A string representing the character c.
-    */
-    std::string char_to_string( const char & c )
-    {
-        std::string s(1, c);
-        return s;
-    }
+            iterator & operator++()
+            {
+                ++m_index;
+                return *this;
+            }
 
+            iterator operator++(int)
+            {
+                iterator previous = *this;
+                ++m_index;
+                return previous;
+            }
 
-    /**
-     * Predicate function for eraseNonNumericChars. It performs a logical not operation on the result of the isdigit() function.
-     *
-     * Parameter:
-     *  const char & c - The character we'd like to check to see if it is not a digit.
-     *
-     * Returns:
-     *  bool - True if c is not a digit, false otherwise.
-    */
-    bool isNotDigit(    const char & c  )
-    {
-        return !(isdigit(c));
-    }
+            iterator & operator--()
+            {
+                --m_index;
+                return *this;
+            }
+
+            iterator operator--(int)
+            {
+                iterator previous = *this;
+                --m_index;
+                return previous;
+            }
+
+            iterator & operator+=( difference_type offset )
+            {
+                m_index += offset;
+                return *this;
+            }
+
+            iterator & operator-=( difference_type offset )
+            {
+                m_index -= offset;
+                return *this;
+            }
+
+            friend iterator operator+(  iterator it,
+                                        difference_type offset  )
+            {
+                return it += offset;
+            }
+
+            friend iterator operator+(  difference_type offset,
+                                        iterator it )
+            {
+                return it += offset;
+            }
+
+            friend iterator operator-(  iterator it,
+                                        difference_type offset  )
+            {
+                return it -= offset;
+            }
+
+            friend difference_type operator-(   const iterator & a,
+                                                const iterator & b  )
+            {
+                return difference_type(a.m_index) - difference_type(b.m_index);
+            }
+
+            friend bool operator==( const iterator & a,
+                                    const iterator & b  )
+            {
+                return a.m_index == b.m_index;
+            }
+
+            friend auto operator<=>(    const iterator & a,
+                                        const iterator & b  )
+            {
+                return a.m_index <=> b.m_index;
+            }
+
+        private:
+            const CyclicView * m_view = nullptr;
+            std::size_t m_index = 0;
+        };
+
+        CyclicView() = default;
+
+        /**
+         * Creates a view of str rotated left by rotation characters. The rotation is taken modulo the length of str,
+         * and negative rotations turn right.
+         */
+        explicit CyclicView(    std::string_view str,
+                                std::ptrdiff_t rotation = 0 )
+            : m_str(str)
+        {
+            if(!str.empty())
+            {
+                const std::ptrdiff_t length = str.size();
+                std::ptrdiff_t offset = rotation % length;
+                offset += length & (offset >> std::numeric_limits<std::ptrdiff_t>::digits);
+                m_offset = offset;
+            }
+        }
+
+        std::size_t size() const
+        {
+            return m_str.size();
+        }
+
+        bool empty() const
+        {
+            return m_str.empty();
+        }
+
+        /**
+         * Returns the i-th character of the rotated string. i must be lower than size().
+         */
+        char operator[]( std::size_t i ) const
+        {
+            std::size_t position = m_offset + i;
+            if(position >= m_str.size())
+            {
+                position -= m_str.size();
+            }
+            return m_str[position];
+        }
+
+        /**
+         * Returns the position in the underlying string where this view starts.
+         */
+        std::size_t rotation() const
+        {
+            return m_offset;
+        }
+
+        std::string_view underlying() const
+        {
+            return m_str;
+        }
+
+        /**
+         * Returns a view of the same string, rotated left by k more characters (right if k is negative).
+         */
+        CyclicView rotated( std::ptrdiff_t k ) const
+        {
+            return CyclicView(m_str, std::ptrdiff_t(m_offset) + k);
+        }
+
+        /**
+         * The view is made of two contiguous pieces of the underlying string: head() is read first, then tail().
+         */
+        std::string_view head() const
+        {
+            return m_str.substr(m_offset);
+        }
+
+        std::string_view tail() const
+        {
+            return m_str.substr(0, m_offset);
+        }
+
+        iterator begin() const
+        {
+            return iterator(this, 0);
+        }
+
+        iterator end() const
+        {
+            return iterator(this, m_str.size());
+        }
+
+        /**
+         * Copies the rotated string.
+         */
+        std::string toString() const
+        {
+            std::string result;
+            result.reserve(m_str.size());
+            result.append(head());
+            result.append(tail());
+            return result;
+        }
+
+        /**
+         * Lexicographic comparison of the rotated contents of two views. Works on the contiguous pieces of both views
+         * with at most three memcmp-like comparisons.
+         */
+        friend std::strong_ordering operator<=>(    const CyclicView & a,
+                                                    const CyclicView & b    )
+        {
+            std::string_view aPieces[2] = {a.head(), a.tail()};
+            std::string_view bPieces[2] = {b.head(), b.tail()};
+            std::size_t i = 0;
+            std::size_t j = 0;
+            while((i < 2) && (j < 2))
+            {
+                if(aPieces[i].empty())
+                {
+                    ++i;
+                    continue;
+                }
+                if(bPieces[j].empty())
+                {
+                    ++j;
+                    continue;
+                }
+                const std::size_t length = std::min(aPieces[i].size(), bPieces[j].size());
+                const int order = aPieces[i].substr(0, length).compare(bPieces[j].substr(0, length));
+                if(order != 0)
+                {
+                    return (order < 0) ? std::strong_ordering::less : std::strong_ordering::greater;
+                }
+                aPieces[i].remove_prefix(length);
+                bPieces[j].remove_prefix(length);
+            }
+            return a.size() <=> b.size();
+        }
+
+        friend bool operator==( const CyclicView & a,
+                                const CyclicView & b    )
+        {
+            return (a.size() == b.size()) && ((a <=> b) == 0);
+        }
+
+    private:
+        std::string_view m_str;
+        std::size_t m_offset = 0;
+    };
 
 
     /**
-     * Erases all non-numeric characters from a string and returns it.
+     * Rotates a string left by k characters in place (right if k is negative), e.g. "hello" rotated by 2 gives
+     * "llohe". k is taken modulo the length of the string.
      *
-     * Parameter:
-     *  std::string str - The string to release all non-numeric chars from.
+     * @param str - The string to rotate.
+     * @param k - The number of characters to rotate by.
+     */
+    void rotateInPlace( std::string & str,
+                        std::ptrdiff_t k    )
+    {
+        const CyclicView view(str, k);
+        std::rotate(str.begin(), str.begin() + view.rotation(), str.end());
+    }
+
+
+    /**
+     * Finds the rotation of a string that is lexicographically the smallest, in linear time and constant memory. Two
+     * candidate rotations i and j are compared character by character; when they differ after k matching characters,
+     * the loser and the k rotations following it can be discarded at once.
      *
-     * Returns:
-     *  The string parameter we passed in, but all of its non-numeric characters removed from it.
-    */
-    std::string eraseNonNumericChars( std::string str )
+     * Two strings are rotations of each other if and only if their minimal rotations are equal, which makes
+     * CyclicView(str, minimalRotation(str)) a canonical form for cyclic strings.
+     *
+     * @param str - The string whose rotations are considered.
+     *
+     * @retval std::size_t - The rotation (see CyclicView) giving the smallest string; the smallest such index if
+     *                       several rotations are equal. 0 for an empty string.
+     */
+    std::size_t minimalRotation( std::string_view str )
     {
-        // JJO: I don't see the point of isNotDigit, a lambda would be perfect here.
-        str.erase(std::remove_if(str.begin(), str.end(), isNotDigit), str.end());
-        return str;
+        const std::size_t n = str.size();
+        std::size_t i = 0;
+        std::size_t j = 1;
+        std::size_t k = 0;
+        while((i < n) && (j < n) && (k < n))
+        {
+            std::size_t a = i + k;
+            std::size_t b = j + k;
+            a -= (a >= n) ? n : 0;
+            b -= (b >= n) ? n : 0;
+            if(str[a] == str[b])
+            {
+                ++k;
+                continue;
+            }
+            if(str[a] > str[b])
+            {
+                i += k + 1;
+            }
+            else
+            {
+                j += k + 1;
+            }
+            if(i == j)
+            {
+                ++j;
+            }
+            k = 0;
+        }
+        return std::min(i, j);
     }
 
 
     /**
-     * Reverses the order of a string's characters using std::reverse().
+     * Finds all the positions of a cyclic string where a pattern starts, letting the pattern wrap around the end of the
+     * string (possibly several times if it is longer). The search runs Knuth-Morris-Pratt over the text as if it were
+     * repeated, without building the repeated text.
      *
-     * Parameter:
-     *  std::string & str - The string we would like to reverse.
+     * Example: cyclicFindAll("abcab", "bab") returns {4}, the match wrapping from the last 'b' to "ab".
+     *
+     * @param str - The cyclic string to search.
+     * @param pattern - The pattern to look for. An empty pattern matches nowhere.
+     *
+     * @retval std::vector<size_t> - The starting positions in str, in increasing order.
+     */
+    std::vector<size_t> cyclicFindAll(  std::string_view str,
+                                        std::string_view pattern    )
+    {
+        std::vector<size_t> positions;
+        const std::size_t n = str.size();
+        const std::size_t m = pattern.size();
+        if((n == 0) || (m == 0))
+        {
+            return positions;
+        }
+
+        //failure[q] is the length of the longest proper border of pattern[0..q]
+        std::vector<std::size_t> failure(m, 0);
+        for(std::size_t q = 1, k = 0; q < m; ++q)
+        {
+            while((k > 0) && (pattern[q] != pattern[k]))
+            {
+                k = failure[k - 1];
+            }
+            if(pattern[q] == pattern[k])
+            {
+                ++k;
+            }
+            failure[q] = k;
+        }
+
+        //A match starting at position p < n ends at p + m - 1 in the repeated text
+        std::size_t matched = 0;
+        std::size_t position = 0;
+        for(std::size_t i = 0; i < n + m - 1; ++i)
+        {
+            const char c = str[position];
+            position = (position + 1 == n) ? 0 : position + 1;
+            while((matched > 0) && (c != pattern[matched]))
+            {
+                matched = failure[matched - 1];
+            }
+            if(c == pattern[matched])
+            {
+                ++matched;
+            }
+            if(matched == m)
+            {
+                positions.push_back(i + 1 - m);
+                matched = failure[m - 1];
+            }
+        }
+        return positions;
+    }
+
+
+    /**
+     * Checks whether b is a rotation of a, e.g. "erbottlewat" is a rotation of "waterbottle".
+     *
+     * @param a - The first string.
+     * @param b - The second string.
+     *
+     * @retval bool - true if a and b have the same length and b can be obtained by rotating a.
+     */
+    bool isRotation(    std::string_view a,
+                        std::string_view b  )
+    {
+        if(a.size() != b.size())
+        {
+            return false;
+        }
+        return a.empty() || !cyclicFindAll(a, b).empty();
+    }
+
+
+    /**
+     * Given a string str, erase the last n characters of the string. If n is larger than the string, the whole string is
+     * erased; if n is negative, nothing is.
+     *
+     * Taken from: https://thispointer.com/remove-last-n-characters-from-a-string-in-c/
+     *
+     * Parameters:
+     *  std::string str - The string we want to erase characters from the end of.
+     *  int n - The number of characters we want to erase
      *
      * Returns:
-     *  std::string - The reversed string.
+     *  std::string - The string str having n characters erased from the end of it.
     */
-    std::string reverse( std::string str )
+    std::string eraseCharsFromEnd(  std::string str,
+                                    int n   )
     {
-        std::reverse(str.begin(),str.end());
+        const std::size_t count = std::min<std::size_t>(std::max(n, 0), str.size());
+        str.resize(str.size() - count);
         return str;
     }
 
 
     /**
-     * Checks to see if a std::string is a palindrime or not (the reversed order of characters equals the original order of characters).
-     * Note well that character case, spacing, and punctuation present in classic English palindromes like "A man, a plan, a canal, panama"
-     * prevent them from being valid C++ palindromes with this function, as the reverse order of this exact string is "amanap ,lanac a ,nalp a ,nam A" is
-     * not equivalent to the original order of characters.
+     * Returns a view of a string without its first n characters, or an empty view if n is larger than the string.
+     * Nothing is copied.
      *
-     * Credit: https://stackoverflow.com/a/8362657/16511184
+     * @param str - The string to look at.
+     * @param n - The number of characters to drop.
      *
-     * Parameter:
-     *  std::string str - The string we would like to check.
+     * @retval std::string_view - The end of str.
+     */
+    std::string_view dropFront( std::string_view str,
+                                std::size_t n   )
+    {
+        return str.substr(std::min(n, str.size()));
+    }
+
+
+    /**
+     * Returns a view of a string without its last n characters, or an empty view if n is larger than the string. This is
+     * the non-copying version of eraseCharsFromEnd().
      *
-     * Returns:
-     *  bool - true if str is a palindrome, false otherwise.
-    */
-    bool isPalindrome( const std::string & str )
+     * @param str - The string to look at.
+     * @param n - The number of characters to drop.
+     *
+     * @retval std::string_view - The beginning of str.
+     */
+    std::string_view dropBack(  std::string_view str,
+                                std::size_t n   )
+    {
+        return str.substr(0, str.size() - std::min(n, str.size()));
+    }
+
+
+    /**
+     * Returns a view of the first n characters of a string, or of the whole string if it is shorter than n.
+     *
+     * @param str - The string to look at.
+     * @param n - The number of characters to keep.
+     *
+     * @retval std::string_view - The beginning of str.
+     */
+    std::string_view takeFront( std::string_view str,
+                                std::size_t n   )
+    {
+        return str.substr(0, std::min(n, str.size()));
+    }
+
+
+    /**
+     * Returns a view of the last n characters of a string, or of the whole string if it is shorter than n.
+     *
+     * @param str - The string to look at.
+     * @param n - The number of characters to keep.
+     *
+     * @retval std::string_view - The end of str.
+     */
+    std::string_view takeBack(  std::string_view str,
+                                std::size_t n   )
+    {
+        return str.substr(str.size() - std::min(n, str.size()));
+    }
+
+
+    /**
+     * Erases the first n characters of a string in place, or all of them if n is larger than the string.
+     *
+     * @param str - The string to modify.
+     * @param n - The number of characters to erase.
+     */
+    void dropFrontInPlace(  std::string & str,
+                            std::size_t n   )
+    {
+        str.erase(0, std::min(n, str.size()));
+    }
+
+
+    /**
+     * Erases the last n characters of a string in place, or all of them if n is larger than the string. Unlike
+     * eraseCharsFromEnd(), the string is not copied.
+     *
+     * @param str - The string to modify.
+     * @param n - The number of characters to erase.
+     */
+    void dropBackInPlace(   std::string & str,
+                            std::size_t n   )
+    {
+        str.resize(str.size() - std::min(n, str.size()));
+    }
+
+
+    namespace detail
+    {
+        /**
+         * Returns the byte offset just past the first n code points of a UTF-8 string, or its size if it has fewer code
+         * points.
+         */
+        std::size_t utf8OffsetFromFront(    std::string_view str,
+                                            std::size_t n   )
+        {
+            std::size_t offset = 0;
+            while((n > 0) && (offset < str.size()))
+            {
+                //Skip the lead byte, then the continuation bytes following it
+                ++offset;
+                while((offset < str.size()) && ((static_cast<unsigned char>(str[offset]) & 0xC0) == 0x80))
+                {
+                    ++offset;
+                }
+                --n;
+            }
+            return offset;
+        }
+
+
+        /**
+         * Returns the byte offset where the last n code points of a UTF-8 string begin, or 0 if it has fewer code points.
+         */
+        std::size_t utf8OffsetFromBack( std::string_view str,
+                                        std::size_t n   )
+        {
+            std::size_t offset = str.size();
+            while((n > 0) && (offset > 0))
+            {
+                --offset;
+                while((offset > 0) && ((static_cast<unsigned char>(str[offset]) & 0xC0) == 0x80))
+                {
+                    --offset;
+                }
+                --n;
+            }
+            return offset;
+        }
+    }
+
+
+    /**
+     * Code point aware version of dropFront(): drops the first n code points of a UTF-8 string, never cutting a
+     * multibyte sequence in half.
+     *
+     * @param str - The UTF-8 string to look at.
+     * @param n - The number of code points to drop.
+     *
+     * @retval std::string_view - The end of str.
+     */
+    std::string_view dropFrontCodePoints(   std::string_view str,
+                                            std::size_t n   )
+    {
+        return str.substr(detail::utf8OffsetFromFront(str, n));
+    }
+
+
+    /**
+     * Code point aware version of dropBack(): drops the last n code points of a UTF-8 string.
+     *
+     * @param str - The UTF-8 string to look at.
+     * @param n - The number of code points to drop.
+     *
+     * @retval std::string_view - The beginning of str.
+     */
+    std::string_view dropBackCodePoints(    std::string_view str,
+                                            std::size_t n   )
     {
-        return std::equal(str.begin(), str.begin() + str.size()/2, str.rbegin());
+        return str.substr(0, detail::utf8OffsetFromBack(str, n));
     }
 
 
+    /**
+     * Code point aware version of takeFront(): keeps the first n code points of a UTF-8 string.
+     *
+     * @param str - The UTF-8 string to look at.
+     * @param n - The number of code points to keep.
+     *
+     * @retval std::string_view - The beginning of str.
+     */
+    std::string_view takeFrontCodePoints(   std::string_view str,
+                                            std::size_t n   )
+    {
+        return str.substr(0, detail::utf8OffsetFromFront(str, n));
+    }
+
+
+    /**
+     * Code point aware version of takeBack(): keeps the last n code points of a UTF-8 string.
+     *
+     * @param str - The UTF-8 string to look at.
+     * @param n - The number of code points to keep.
+     *
+     * @retval std::string_view - The end of str.
+     */
+    std::string_view takeBackCodePoints(    std::string_view str,
+                                            std::size_t n   )
+    {
+        return str.substr(detail::utf8OffsetFromBack(str, n));
+    }
+
+
+    /**
+     * Given a string str, find all occurrences of a substring within it. Returns a vector of all of the indices that the substring
+     * occurs at within the string str.
+     *
+     * Based off of: https://stackoverflow.com/a/4034809
+     *
+     * Parameters:
+     *  std::string str - The string we are searching for the substring in.
+     *  std::string substr - The substring we are looking for within string str.
+     *
+     * Returns:
+     *  std::vector<size_t> - A vector containing all indices in increasing order that the substr occurs at.
+    */
+    std::vector<size_t> findAll(    std::string str,
+                                    std::string substr  )
+    {
+        std::vector<size_t> positions;
+
+        size_t pos = str.find(substr, 0);
+        while(pos != std::string::npos)
+        {
+            positions.push_back(pos);
+            pos = str.find(substr,pos+1);
+        }
+
+        return positions;
+    }
+
+
+    /**
+     * Given a locale, return all of the whitespace characters for that locale in a string.
+     *
+     * Credit: https://stackoverflow.com/a/36311304/16511184
+     *
+     * Parameter:
+     *  const std::locale & loc - The locale which we want to obtain a string of all whitespace characters for.
+     *
+     * Returns:
+     *  std::string - A string of all whitespace characters defined in the given locale.
+    */
+    std::string getWhitespaceString(const std::locale & loc)
+    {
+        std::string whitespace;
+        for (char ch = std::numeric_limits<char>::min(); ch < std::numeric_limits<char>::max(); ch++)
+            if (std::isspace(ch, loc))
+                whitespace += ch;
+        // to avoid infinte loop check char max outside the for loop.
+        if (std::isspace(std::numeric_limits<char>::max(), std::locale(loc)))
+            whitespace += std::numeric_limits<char>::max();
+        return whitespace;
+    }
+
+
+    /**
+     * Remove all leading and trailing whitespace from a string (spaces, tabs, newlines, etc.), then return it.
+     *
+     * Based on: https://stackoverflow.com/a/1798170
+     *
+     * Parameter:
+     *  std::string str - The string to remove all of the leading and trailing whitespaces from.
+     *
+     * Returns:
+     *  std::string - str modified by removing all of its leading and trailing whitespaces.
+    */
+    std::string trimWhitespace( std::string str )
+    {
+        //Get a string of all of the whitespace characters in the current locale
+        std::string whitespace = getWhitespaceString(std::locale(""));
+
+        const auto strBegin = str.find_first_not_of(whitespace);
+        if (strBegin == std::string::npos)
+        {
+            return ""; // no content
+        }
+
+        const auto strEnd = str.find_last_not_of(whitespace);
+        const auto strRange = strEnd - strBegin + 1;
+
+        return str.substr(strBegin, strRange);
+    }
+
+
+    /**
+     * Non-copying version of trim(): returns a view of str without charsToTrim characters at each end. The view is empty
+     * when the string is too short, but unlike trim() a string of odd length keeps its middle character.
+     *
+     * @param str - The string to trim.
+     * @param charsToTrim - The number of characters to remove from each end.
+     *
+     * @retval std::string_view - The middle of str.
+     */
+    std::string_view trimView(  std::string_view str,
+                                std::size_t charsToTrim )
+    {
+        if(charsToTrim >= (str.size() + 1)/2)
+        {
+            return str.substr(0, 0);
+        }
+        return str.substr(charsToTrim, str.size() - 2*charsToTrim);
+    }
+
+
+    namespace detail
+    {
+#ifdef STEVENSSTRINGLIB_X86_64
+        /**
+         * Returns a 16-bit mask with a bit set for each whitespace byte of v (see CharClassTable). SSE2 is part of
+         * x86-64, so no runtime check is needed.
+         */
+        unsigned int whitespaceMask16( __m128i v )
+        {
+            const __m128i isSpace = _mm_cmpeq_epi8(v, _mm_set1_epi8(' '));
+            //'\t' to '\r' are contiguous: v - '\t' must be at most 4 as an unsigned byte
+            const __m128i fromTab = _mm_sub_epi8(v, _mm_set1_epi8('\t'));
+            const __m128i isControlSpace = _mm_cmpeq_epi8(_mm_min_epu8(fromTab, _mm_set1_epi8(4)), fromTab);
+            return _mm_movemask_epi8(_mm_or_si128(isSpace, isControlSpace));
+        }
+#endif
+
+
+        /**
+         * Returns the index of the first byte that is not whitespace, or length if there is none. Long runs of padding
+         * are skipped 16 bytes at a time.
+         */
+        std::size_t skipLeadingWhitespace(  const char * data,
+                                            std::size_t length  )
+        {
+            std::size_t i = 0;
+#ifdef STEVENSSTRINGLIB_X86_64
+            for(; i + 16 <= length; i += 16)
+            {
+                const unsigned int mask = whitespaceMask16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i)));
+                if(mask != 0xFFFF)
+                {
+                    return i + std::countr_one(mask);
+                }
+            }
+#endif
+            while((i < length) && charClassTable.whitespace[static_cast<unsigned char>(data[i])])
+            {
+                ++i;
+            }
+            return i;
+        }
+
+
+        /**
+         * Returns the index just past the last byte that is not whitespace, or 0 if there is none.
+         */
+        std::size_t skipTrailingWhitespace( const char * data,
+                                            std::size_t length  )
+        {
+            std::size_t end = length;
+#ifdef STEVENSSTRINGLIB_X86_64
+            for(; end >= 16; end -= 16)
+            {
+                const unsigned int mask = whitespaceMask16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + end - 16)));
+                if(mask != 0xFFFF)
+                {
+                    //Count the whitespace bytes at the top of the 16-bit mask
+                    return end - std::countl_one(static_cast<std::uint16_t>(mask));
+                }
+            }
+#endif
+            while((end > 0) && charClassTable.whitespace[static_cast<unsigned char>(data[end - 1])])
+            {
+                --end;
+            }
+            return end;
+        }
+    }
+
+
+    /**
+     * Non-copying version of trimWhitespace(): returns a view of str without its leading and trailing whitespace. Only
+     * the ASCII whitespace characters (space, \t, \n, \v, \f and \r) are trimmed, whatever the locale, which lets long
+     * runs of padding be skipped 16 bytes at a time.
+     *
+     * @param str - The string to trim.
+     *
+     * @retval std::string_view - str without its surrounding whitespace.
+     */
+    std::string_view trimWhitespaceView( std::string_view str )
+    {
+        const std::size_t begin = detail::skipLeadingWhitespace(str.data(), str.size());
+        const std::size_t end = begin + detail::skipTrailingWhitespace(str.data() + begin, str.size() - begin);
+        return str.substr(begin, end - begin);
+    }
+
+
+    //trimAllOf
+
+
+    /**
+     * Given a character c, convert it to a std::string.
+     *
+     * Parameter:
+     *  char c - The character we'd like to convert to a string.
+     *
+     * Returns:
+     *  std::string - A string representing the character c.
+    */
+    std::string char_to_string( const char & c )
+    {
+        std::string s(1, c);
+        return s;
+    }
+
+
+    /**
+     * Predicate function for eraseNonNumericChars. It performs a logical not operation on the result of the isdigit() function.
+     *
+     * Parameter:
+     *  const char & c - The character we'd like to check to see if it is not a digit.
+     *
+     * Returns:
+     *  bool - True if c is not a digit, false otherwise.
+    */
+    bool isNotDigit(    const char & c  )
+    {
+        return !(isdigit(c));
+    }
+
+
+    /**
+     * Erases all non-numeric characters from a string and returns it.
+     *
+     * Parameter:
+     *  std::string str - The string to release all non-numeric chars from.
+     *
+     * Returns:
+     *  The string parameter we passed in, but all of its non-numeric characters removed from it.
+    */
+    std::string eraseNonNumericChars( std::string str )
+    {
+        // JJO: I don't see the point of isNotDigit, a lambda would be perfect here.
+        str.erase(std::remove_if(str.begin(), str.end(), isNotDigit), str.end());
+        return str;
+    }
+
+
+    /**
+     * Options for extractNumbers() and forEachNumber().
+     *
+     *  allowSign - A '+' or '-' directly before a number is part of it, unless it follows a letter or a digit (so that
+     *              the dashes of "2024-01-05" are not read as signs).
+     *  allowDecimal - Numbers may have a fractional part, e.g. "3.14" or ".5".
+     *  allowExponent - Numbers may have an exponent, e.g. "6.02e23".
+     *  groupSeparator - If not '\0', digits may be grouped by three with this character, e.g. "1,234,567".
+     *  decimalPoint - The character separating the integer and fractional parts.
+     */
+    struct NumberScanOptions
+    {
+        bool allowSign = true;
+        bool allowDecimal = true;
+        bool allowExponent = true;
+        char groupSeparator = '\0';
+        char decimalPoint = '.';
+    };
+
+
+    /**
+     * A number found in a string by extractNumbers() or forEachNumber(). text points into the scanned string and keeps
+     * the number exactly as written; value is its value as a double, so integers past 2^53 lose precision.
+     */
+    struct ExtractedNumber
+    {
+        std::string_view text;
+        double value;
+        bool isInteger;
+    };
+
+
+    namespace detail
+    {
+        bool isDigit( char c )
+        {
+            return static_cast<unsigned char>(c - '0') < 10;
+        }
+
+
+#ifdef STEVENSSTRINGLIB_X86_64
+        /**
+         * Returns a 16-bit mask of the bytes of a block that are ASCII digits. SSE2 only compares signed bytes, so the
+         * bytes are shifted to put '0' at 0 and an unsigned minimum does the range check.
+         */
+        unsigned digitMask16( __m128i block )
+        {
+            const __m128i offset = _mm_sub_epi8(block, _mm_set1_epi8('0'));
+            return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(offset, _mm_set1_epi8(9)), offset)));
+        }
+#endif
+
+
+        /**
+         * Returns a pointer to the first character in [p, end) that is not a digit, or end.
+         */
+        const char * skipDigits(    const char * p,
+                                    const char * end    )
+        {
+#ifdef STEVENSSTRINGLIB_X86_64
+            while(end - p >= 16)
+            {
+                const unsigned mask = digitMask16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+                if(mask != 0xFFFF)
+                {
+                    return p + std::countr_one(mask);
+                }
+                p += 16;
+            }
+#endif
+            while((p != end) && isDigit(*p))
+            {
+                ++p;
+            }
+            return p;
+        }
+
+
+        /**
+         * Returns a pointer to the first digit in [p, end), or end.
+         */
+        const char * findDigit(     const char * p,
+                                    const char * end    )
+        {
+#ifdef STEVENSSTRINGLIB_X86_64
+            while(end - p >= 16)
+            {
+                const unsigned mask = digitMask16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+                if(mask != 0)
+                {
+                    return p + std::countr_zero(mask);
+                }
+                p += 16;
+            }
+#endif
+            while((p != end) && !isDigit(*p))
+            {
+                ++p;
+            }
+            return p;
+        }
+
+
+        /**
+         * Converts the text of a number found by forEachNumber() to a double.
+         */
+        double numberValue(     std::string_view text,
+                                bool plainText,
+                                const NumberScanOptions & options   )
+        {
+            const bool negative = (text.front() == '-');
+            if((text.front() == '-') || (text.front() == '+'))
+            {
+                text.remove_prefix(1);
+            }
+
+            //std::from_chars() only understands '.' and no group separators, so anything else is copied without them,
+            //on the stack unless the number is absurdly long
+            std::array<char, 256> buffer;
+            std::string longNumber;
+            if(!plainText)
+            {
+                char * normalized = buffer.data();
+                if(text.size() > buffer.size())
+                {
+                    longNumber.resize(text.size());
+                    normalized = longNumber.data();
+                }
+                std::size_t length = 0;
+                for(char c : text)
+                {
+                    if(c == options.decimalPoint)
+                    {
+                        normalized[length++] = '.';
+                    }
+                    else if(c != options.groupSeparator)
+                    {
+                        normalized[length++] = c;
+                    }
+                }
+                text = std::string_view(normalized, length);
+            }
+
+            double value = 0;
+            const std::from_chars_result result = std::from_chars(text.data(), text.data() + text.size(), value);
+            if(result.ec == std::errc::result_out_of_range)
+            {
+                //Too large or too small for a double: negative exponents underflow, anything else overflows
+                const std::size_t exponent = text.find_first_of("eE");
+                const bool underflow = (exponent != std::string_view::npos) && (exponent + 1 < text.size()) && (text[exponent + 1] == '-');
+                value = underflow ? 0.0 : std::numeric_limits<double>::infinity();
+            }
+            return negative ? -value : value;
+        }
+    }
+
+
+    /**
+     * Finds every number in a string in a single pass, and calls callback(const ExtractedNumber &) for each of them
+     * in order. Runs of digits, and the text between numbers, are skipped 16 bytes at a time with SSE2 on x86-64.
+     *
+     * A number is a run of digits, optionally with a sign, digit groups, a fractional part and an exponent, as
+     * allowed by options. Anything that does not fit is left out, e.g. "5." is read as 5 and "3e" as 3.
+     *
+     * Throws std::invalid_argument if the group separator and the decimal point are the same character.
+     *
+     * @param str - The string to scan, e.g. a log line.
+     * @param callback - Called with each number found.
+     * @param options - Which number syntaxes are recognised.
+     */
+    template<typename Callback>
+    void forEachNumber(     std::string_view str,
+                            Callback && callback,
+                            const NumberScanOptions & options = {}  )
+    {
+        if((options.groupSeparator != '\0') && (options.groupSeparator == options.decimalPoint))
+        {
+            throw std::invalid_argument("forEachNumber(): the group separator and the decimal point must differ");
+        }
+
+        const char * const begin = str.data();
+        const char * const end = begin + str.size();
+        //Characters before consumed belong to the previous number and cannot start a new one
+        const char * consumed = begin;
+        const char * p = begin;
+        while((p = detail::findDigit(p, end)) != end)
+        {
+            const char * start = p;
+            bool isInteger = true;
+            bool plainText = (options.decimalPoint == '.');
+
+            const bool fractionOnly = options.allowDecimal && (start - consumed >= 1) && (start[-1] == options.decimalPoint)
+                                      && ((start - begin == 1) || !detail::isDigit(start[-2]));
+            if(fractionOnly)
+            {
+                --start;
+                isInteger = false;
+            }
+            if(options.allowSign && (start > consumed) && ((start[-1] == '-') || (start[-1] == '+'))
+               && ((start - 1 == begin) || !detail::charClassTable.alphanumeric[static_cast<unsigned char>(start[-2])]))
+            {
+                --start;
+            }
+
+            const char * const digits = p;
+            p = detail::skipDigits(p, end);
+            if(!fractionOnly)
+            {
+                //Groups of exactly three digits may follow a leading group of one to three
+                if((options.groupSeparator != '\0') && (p - digits <= 3))
+                {
+                    while((end - p >= 4) && (*p == options.groupSeparator) && detail::isDigit(p[1]) && detail::isDigit(p[2])
+                          && detail::isDigit(p[3]) && ((end - p == 4) || !detail::isDigit(p[4])))
+                    {
+                        p += 4;
+                        plainText = false;
+                    }
+                }
+                if(options.allowDecimal && (end - p >= 2) && (*p == options.decimalPoint) && detail::isDigit(p[1]))
+                {
+                    p = detail::skipDigits(p + 1, end);
+                    isInteger = false;
+                }
+            }
+            if(options.allowExponent && (p != end) && ((*p == 'e') || (*p == 'E')))
+            {
+                const char * exponent = p + 1;
+                if((exponent != end) && ((*exponent == '-') || (*exponent == '+')))
+                {
+                    ++exponent;
+                }
+                if((exponent != end) && detail::isDigit(*exponent))
+                {
+                    p = detail::skipDigits(exponent, end);
+                    isInteger = false;
+                }
+            }
+
+            const std::string_view text(start, p - start);
+            callback(ExtractedNumber{text, detail::numberValue(text, plainText, options), isInteger});
+            consumed = p;
+        }
+    }
+
+
+    /**
+     * Finds every number in a string, as forEachNumber() does, and stores them in numbers. The vector is cleared first
+     * but keeps its capacity, so it can be reused across calls without allocating.
+     *
+     * @param str - The string to scan.
+     * @param numbers - Receives the numbers found, in order.
+     * @param options - Which number syntaxes are recognised.
+     */
+    void extractNumbers(    std::string_view str,
+                            std::vector<ExtractedNumber> & numbers,
+                            const NumberScanOptions & options = {}  )
+    {
+        numbers.clear();
+        forEachNumber(str, [&numbers](const ExtractedNumber & number) { numbers.push_back(number); }, options);
+    }
+
+
+    /**
+     * Returns every number in a string, as forEachNumber() finds them, e.g. extractNumbers("took 12.5ms, -3 retries")
+     * returns 12.5 and -3.
+     *
+     * @param str - The string to scan.
+     * @param options - Which number syntaxes are recognised.
+     *
+     * @retval std::vector<ExtractedNumber> - The numbers found, in order.
+     */
+    std::vector<ExtractedNumber> extractNumbers(    std::string_view str,
+                                                    const NumberScanOptions & options = {}  )
+    {
+        std::vector<ExtractedNumber> numbers;
+        extractNumbers(str, numbers, options);
+        return numbers;
+    }
+
+
+    namespace detail
+    {
+        constexpr char digitPairs[] =
+            "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+            "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+            "8081828384858687888990919293949596979899";
+
+        constexpr std::uint64_t powersOf10[20] = {  1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull,
+                                                    10000000ull, 100000000ull, 1000000000ull, 10000000000ull,
+                                                    100000000000ull, 1000000000000ull, 10000000000000ull,
+                                                    100000000000000ull, 1000000000000000ull, 10000000000000000ull,
+                                                    100000000000000000ull, 1000000000000000000ull,
+                                                    10000000000000000000ull };
+
+
+        /**
+         * Returns the number of decimal digits of value. log10(2) is about 1233/4096, so the bit width gives the digit
+         * count up to one, which a single comparison settles.
+         */
+        std::size_t countDecimalDigits( std::uint64_t value )
+        {
+            const std::size_t estimate = (std::bit_width(value | 1) * 1233) >> 12;
+            return estimate + 1 - ((value | 1) < powersOf10[estimate]);
+        }
+
+
+        /**
+         * Writes the digits of value to out, two at a time from the digit pair table, and returns a pointer past them.
+         */
+        char * writeDecimal(    char * out,
+                                std::uint64_t value )
+        {
+            char * const end = out + countDecimalDigits(value);
+            char * p = end;
+            while(value >= 100)
+            {
+                p -= 2;
+                std::memcpy(p, digitPairs + (value % 100) * 2, 2);
+                value /= 100;
+            }
+            if(value >= 10)
+            {
+                std::memcpy(p - 2, digitPairs + value * 2, 2);
+            }
+            else
+            {
+                p[-1] = static_cast<char>('0' + value);
+            }
+            return end;
+        }
+
+
+        /**
+         * Inserts a separator between groups of three digits in the leading run of digits of [begin, end), after an
+         * optional '-'. The characters are moved right in place, so there must be room for the separators after end.
+         * Returns the new end.
+         */
+        char * groupDigits(     char * begin,
+                                char * end,
+                                char separator  )
+        {
+            char * digits = begin + ((begin != end) && (*begin == '-'));
+            char * digitsEnd = digits;
+            while((digitsEnd != end) && isDigit(*digitsEnd))
+            {
+                ++digitsEnd;
+            }
+            const std::size_t digitCount = digitsEnd - digits;
+            if(digitCount <= 3)
+            {
+                return end;
+            }
+            const std::size_t separators = (digitCount - 1) / 3;
+            std::memmove(digitsEnd + separators, digitsEnd, end - digitsEnd);
+
+            //Copy the digits from the right, placing a separator after every third one
+            char * from = digitsEnd;
+            char * to = digitsEnd + separators;
+            for(std::size_t i = 0; i < separators; ++i)
+            {
+                //The group and its destination overlap once a separator has been placed
+                from -= 3;
+                to -= 3;
+                std::memmove(to, from, 3);
+                *--to = separator;
+            }
+            return end + separators;
+        }
+
+
+        /**
+         * The buffer size formatFloat() needs for any value at a given precision, with room for digit groups.
+         */
+        std::size_t floatFormatCapacity( int precision )
+        {
+            //Shortest round-trip output is at most 24 characters; fixed output of the largest double has 309 digits,
+            //plus up to 103 separators, a sign, a point and the fractional digits
+            return (precision < 0) ? 32 : 416 + static_cast<std::size_t>(precision);
+        }
+    }
+
+
+    /**
+     * Writes an integer in decimal into a caller-provided buffer, without allocating or consulting the locale. Digits
+     * are produced two at a time from a lookup table. 27 characters are always enough, separators included.
+     *
+     * Throws std::invalid_argument if the buffer is too small.
+     *
+     * @param value - The integer to format.
+     * @param buffer - Where the characters are written. No null terminator is added.
+     * @param groupSeparator - If not '\0', inserted between groups of three digits, e.g. "1,234,567".
+     *
+     * @retval std::size_t - The number of characters written.
+     */
+    template<std::integral T>
+    std::size_t formatInteger(  T value,
+                                std::span<char> buffer,
+                                char groupSeparator = '\0'  )
+    {
+        char scratch[27];
+        char * p = scratch;
+        std::uint64_t magnitude = static_cast<std::uint64_t>(value);
+        if constexpr(std::is_signed_v<T>)
+        {
+            if(value < 0)
+            {
+                *p++ = '-';
+                //Negating in unsigned arithmetic also works for the most negative value
+                magnitude = 0 - magnitude;
+            }
+        }
+        char * end = detail::writeDecimal(p, magnitude);
+        if(groupSeparator != '\0')
+        {
+            end = detail::groupDigits(scratch, end, groupSeparator);
+        }
+
+        const std::size_t length = end - scratch;
+        if(length > buffer.size())
+        {
+            throw std::invalid_argument("formatInteger(): the buffer is too small");
+        }
+        std::memcpy(buffer.data(), scratch, length);
+        return length;
+    }
+
+
+    /**
+     * Returns an integer formatted in decimal, as formatInteger(value, buffer, groupSeparator) writes it.
+     */
+    template<std::integral T>
+    std::string formatInteger(  T value,
+                                char groupSeparator = '\0'  )
+    {
+        char buffer[27];
+        return std::string(buffer, formatInteger(value, std::span<char>(buffer), groupSeparator));
+    }
+
+
+    /**
+     * Writes a floating-point number into a caller-provided buffer with std::to_chars(), without allocating or
+     * consulting the locale. By default the output is the shortest string that reads back as the same value, e.g.
+     * "0.1" or "1e+20"; a precision gives fixed notation with that many fractional digits instead. 32 characters are
+     * always enough for the shortest form.
+     *
+     * Throws std::invalid_argument if the buffer is too small.
+     *
+     * @param value - The number to format.
+     * @param buffer - Where the characters are written. No null terminator is added.
+     * @param precision - The number of fractional digits, or -1 for the shortest round-trip form.
+     * @param groupSeparator - If not '\0', inserted between groups of three digits of the integer part.
+     *
+     * @retval std::size_t - The number of characters written.
+     */
+    std::size_t formatFloat(    double value,
+                                std::span<char> buffer,
+                                int precision = -1,
+                                char groupSeparator = '\0'  )
+    {
+        char * const begin = buffer.data();
+        char * const last = begin + buffer.size();
+        const std::to_chars_result result = (precision < 0) ? std::to_chars(begin, last, value)
+                                                            : std::to_chars(begin, last, value, std::chars_format::fixed, precision);
+        if(result.ec != std::errc())
+        {
+            throw std::invalid_argument("formatFloat(): the buffer is too small");
+        }
+        char * end = result.ptr;
+        if(groupSeparator != '\0')
+        {
+            //Check the room the separators need before moving anything
+            const char * digits = begin + (*begin == '-');
+            std::size_t digitCount = 0;
+            while((digits + digitCount != end) && detail::isDigit(digits[digitCount]))
+            {
+                ++digitCount;
+            }
+            if((digitCount > 3) && (static_cast<std::size_t>(last - end) < (digitCount - 1) / 3))
+            {
+                throw std::invalid_argument("formatFloat(): the buffer is too small");
+            }
+            end = detail::groupDigits(begin, end, groupSeparator);
+        }
+        return end - begin;
+    }
+
+
+    /**
+     * Returns a floating-point number formatted as formatFloat(value, buffer, precision, groupSeparator) writes it.
+     */
+    std::string formatFloat(    double value,
+                                int precision = -1,
+                                char groupSeparator = '\0'  )
+    {
+        std::string formatted(detail::floatFormatCapacity(precision), '\0');
+        formatted.resize(formatFloat(value, std::span<char>(formatted), precision, groupSeparator));
+        return formatted;
+    }
+
+
+    /**
+     * A column of formatted values stored back to back in one buffer. Value i is buffer[offsets[i], offsets[i + 1]),
+     * so offsets holds one more entry than there are values.
+     */
+    struct FormattedColumn
+    {
+        std::string buffer;
+        std::vector<std::size_t> offsets;
+
+        std::size_t size() const
+        {
+            return offsets.empty() ? 0 : offsets.size() - 1;
+        }
+
+        std::string_view operator[]( std::size_t i ) const
+        {
+            return std::string_view(buffer).substr(offsets[i], offsets[i + 1] - offsets[i]);
+        }
+    };
+
+
+    /**
+     * Formats a whole column of integers into one contiguous buffer, with two allocations for the entire column.
+     *
+     * @param values - The integers to format.
+     * @param groupSeparator - If not '\0', inserted between groups of three digits.
+     *
+     * @retval FormattedColumn - The formatted values and their offsets in the buffer.
+     */
+    template<std::integral T>
+    FormattedColumn formatIntegers(     std::span<const T> values,
+                                        char groupSeparator = '\0'  )
+    {
+        FormattedColumn column;
+        column.buffer.resize(values.size() * 27);
+        column.offsets.resize(values.size() + 1);
+        std::size_t used = 0;
+        for(std::size_t i = 0; i < values.size(); ++i)
+        {
+            column.offsets[i] = used;
+            used += formatInteger(values[i], std::span<char>(column.buffer).subspan(used), groupSeparator);
+        }
+        column.offsets[values.size()] = used;
+        column.buffer.resize(used);
+        return column;
+    }
+
+
+    /**
+     * Formats a whole column of floating-point numbers into one contiguous buffer, as formatFloat() formats each of
+     * them.
+     *
+     * @param values - The numbers to format.
+     * @param precision - The number of fractional digits, or -1 for the shortest round-trip form.
+     * @param groupSeparator - If not '\0', inserted between groups of three digits of the integer parts.
+     *
+     * @retval FormattedColumn - The formatted values and their offsets in the buffer.
+     */
+    FormattedColumn formatFloats(   std::span<const double> values,
+                                    int precision = -1,
+                                    char groupSeparator = '\0'  )
+    {
+        const std::size_t capacity = detail::floatFormatCapacity(precision);
+        FormattedColumn column;
+        //Most values are far shorter than the worst case, so the buffer grows as needed instead
+        column.buffer.resize(values.size() * std::min<std::size_t>(capacity, 24));
+        column.offsets.resize(values.size() + 1);
+        std::size_t used = 0;
+        for(std::size_t i = 0; i < values.size(); ++i)
+        {
+            if(column.buffer.size() - used < capacity)
+            {
+                column.buffer.resize(std::max(column.buffer.size() * 2, used + capacity));
+            }
+            column.offsets[i] = used;
+            used += formatFloat(values[i], std::span<char>(column.buffer).subspan(used), precision, groupSeparator);
+        }
+        column.offsets[values.size()] = used;
+        column.buffer.resize(used);
+        return column;
+    }
+
+
+    /**
+     * The outcome of parsing one cell with parseIntegers().
+     */
+    enum class ParseStatus : std::uint8_t
+    {
+        ok,
+        empty,
+        invalidCharacter,
+        outOfRange
+    };
+
+
+    namespace detail
+    {
+        /**
+         * Returns whether the 8 bytes of a little-endian word are all ASCII digits: their high nibbles must be 3, and
+         * adding 6 must not carry out of the low nibbles.
+         */
+        bool allDigits8( std::uint64_t word )
+        {
+            return ((word & 0xF0F0F0F0F0F0F0F0ULL) == 0x3030303030303030ULL)
+                && (((word + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) == 0x3030303030303030ULL);
+        }
+
+
+        /**
+         * Converts 8 ASCII digits loaded as a little-endian word (first digit in the lowest byte) to their value with
+         * three multiply-adds, combining pairs of digits, then pairs of pairs, then the two halves.
+         */
+        std::uint32_t parseDigits8( std::uint64_t word )
+        {
+            word = ((word & 0x0F0F0F0F0F0F0F0FULL) * (10 * 0x100 + 1)) >> 8;
+            word = ((word & 0x00FF00FF00FF00FFULL) * (100 * 0x10000 + 1)) >> 16;
+            word = ((word & 0x0000FFFF0000FFFFULL) * (10000 * 0x100000000ULL + 1)) >> 32;
+            return static_cast<std::uint32_t>(word);
+        }
+
+
+        /**
+         * Parses a decimal integer with an optional sign, 8 digits at a time. The leading block of fewer than 8 digits
+         * is left-padded with '0' so that it goes through the same multiply-adds.
+         */
+        ParseStatus parseInt64Swar(     std::string_view cell,
+                                        std::int64_t & value    )
+        {
+            value = 0;
+            if(cell.empty())
+            {
+                return ParseStatus::empty;
+            }
+            const bool negative = (cell.front() == '-');
+            if(negative || (cell.front() == '+'))
+            {
+                cell.remove_prefix(1);
+                if(cell.empty())
+                {
+                    return ParseStatus::invalidCharacter;
+                }
+            }
+            while((cell.size() > 1) && (cell.front() == '0'))
+            {
+                cell.remove_prefix(1);
+            }
+            //Leading zeros are gone, so anything longer than 19 characters is too large or not a number
+            if(cell.size() > 19)
+            {
+                return std::all_of(cell.begin(), cell.end(), isDigit) ? ParseStatus::outOfRange : ParseStatus::invalidCharacter;
+            }
+
+            std::uint64_t magnitude = 0;
+            const char * p = cell.data();
+            std::size_t remaining = cell.size();
+            const std::size_t head = remaining % 8;
+            if(head != 0)
+            {
+                //Put the head digits in the high bytes of the word and '0' in the low ones. With 8 bytes or more to
+                //read, a shifted load does it without a variable-length copy.
+                std::uint64_t word = 0x3030303030303030ULL;
+                if(remaining >= 8)
+                {
+                    word = (load64(p) << (8 * (8 - head))) | (word >> (8 * head));
+                }
+                else
+                {
+                    for(std::size_t i = 0; i < head; ++i)
+                    {
+                        word = (word >> 8) | (static_cast<std::uint64_t>(static_cast<unsigned char>(p[i])) << 56);
+                    }
+                }
+                if(!allDigits8(word))
+                {
+                    return ParseStatus::invalidCharacter;
+                }
+                magnitude = parseDigits8(word);
+                p += head;
+                remaining -= head;
+            }
+            for(; remaining != 0; remaining -= 8, p += 8)
+            {
+                const std::uint64_t word = load64(p);
+                if(!allDigits8(word))
+                {
+                    return ParseStatus::invalidCharacter;
+                }
+                magnitude = magnitude * 100000000 + parseDigits8(word);
+            }
+
+            const std::uint64_t limit = static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()) + negative;
+            if(magnitude > limit)
+            {
+                return ParseStatus::outOfRange;
+            }
+            value = negative ? static_cast<std::int64_t>(0 - magnitude) : static_cast<std::int64_t>(magnitude);
+            return ParseStatus::ok;
+        }
+
+
+        /**
+         * The same as parseInt64Swar(), with std::from_chars(), for big-endian targets.
+         */
+        ParseStatus parseInt64Scalar(   std::string_view cell,
+                                        std::int64_t & value    )
+        {
+            value = 0;
+            if(cell.empty())
+            {
+                return ParseStatus::empty;
+            }
+            const char * first = cell.data() + (cell.front() == '+');
+            const char * last = cell.data() + cell.size();
+            std::int64_t parsed = 0;
+            const std::from_chars_result result = std::from_chars(first, last, parsed);
+            if(result.ec == std::errc::result_out_of_range)
+            {
+                return ParseStatus::outOfRange;
+            }
+            if((result.ec != std::errc()) || (result.ptr != last) || (first == last) || ((first != cell.data()) && (*first == '-')))
+            {
+                return ParseStatus::invalidCharacter;
+            }
+            value = parsed;
+            return ParseStatus::ok;
+        }
+    }
+
+
+    /**
+     * Parses a column of decimal integers, e.g. the cells returned by separate(). Each cell must be an optional sign
+     * followed by digits, with nothing around them. Digits are converted 8 at a time with SWAR multiply-adds on a 64-bit
+     * word, which also checks that they are all digits.
+     *
+     * Failures do not stop the batch: the status of each cell is reported, and the value of a failed cell is set to 0.
+     *
+     * Throws std::invalid_argument if values or statuses is not the size of cells.
+     *
+     * @param cells - The strings to parse.
+     * @param values - Receives the value of each cell.
+     * @param statuses - Receives the outcome of each cell.
+     *
+     * @retval std::size_t - The number of cells that failed to parse.
+     */
+    template<typename Cell>
+    requires std::convertible_to<const Cell &, std::string_view>
+    std::size_t parseIntegers(  std::span<const Cell> cells,
+                                std::span<std::int64_t> values,
+                                std::span<ParseStatus> statuses )
+    {
+        if((values.size() != cells.size()) || (statuses.size() != cells.size()))
+        {
+            throw std::invalid_argument("parseIntegers(): values and statuses must have one element per cell");
+        }
+        std::size_t failures = 0;
+        for(std::size_t i = 0; i < cells.size(); ++i)
+        {
+            const std::string_view cell = cells[i];
+            if constexpr(std::endian::native == std::endian::little)
+            {
+                statuses[i] = detail::parseInt64Swar(cell, values[i]);
+            }
+            else
+            {
+                statuses[i] = detail::parseInt64Scalar(cell, values[i]);
+            }
+            failures += (statuses[i] != ParseStatus::ok);
+        }
+        return failures;
+    }
+
+
+    /**
+     * Parses a column of decimal integers as parseIntegers(cells, values, statuses) does, resizing the vectors to the
+     * number of cells.
+     */
+    template<typename Cell>
+    requires std::convertible_to<const Cell &, std::string_view>
+    std::size_t parseIntegers(  const std::vector<Cell> & cells,
+                                std::vector<std::int64_t> & values,
+                                std::vector<ParseStatus> & statuses )
+    {
+        values.resize(cells.size());
+        statuses.resize(cells.size());
+        return parseIntegers(std::span<const Cell>(cells), std::span<std::int64_t>(values), std::span<ParseStatus>(statuses));
+    }
+
+
+    namespace detail
+    {
+        /**
+         * The parts of a decimal string, with the leading zeros of the integer part and the trailing zeros of the
+         * fractional part removed, so that equal values have equal parts. Zero has both parts empty and no sign.
+         */
+        struct DecimalParts
+        {
+            bool negative = false;
+            std::string_view integer;
+            std::string_view fraction;
+        };
+
+
+        /**
+         * Splits a string of the form [+-]digits[.digits] into its parts, scanning the digits 16 at a time. Returns
+         * false if the string is not of that form, or if allowFraction is false and it has a fractional part.
+         */
+        bool splitDecimal(  std::string_view str,
+                            DecimalParts & parts,
+                            bool allowFraction = true   )
+        {
+            parts = DecimalParts();
+            if(!str.empty() && ((str.front() == '-') || (str.front() == '+')))
+            {
+                parts.negative = (str.front() == '-');
+                str.remove_prefix(1);
+            }
+            const char * const begin = str.data();
+            const char * const end = begin + str.size();
+            const char * const integerEnd = skipDigits(begin, end);
+            if(integerEnd == begin)
+            {
+                return false;
+            }
+            parts.integer = std::string_view(begin, integerEnd - begin);
+            if(integerEnd != end)
+            {
+                if(!allowFraction || (*integerEnd != '.'))
+                {
+                    return false;
+                }
+                const char * const fractionEnd = skipDigits(integerEnd + 1, end);
+                if((fractionEnd != end) || (fractionEnd == integerEnd + 1))
+                {
+                    return false;
+                }
+                parts.fraction = std::string_view(integerEnd + 1, fractionEnd - integerEnd - 1);
+            }
+
+            parts.integer.remove_prefix(std::min(parts.integer.find_first_not_of('0'), parts.integer.size()));
+            parts.fraction = parts.fraction.substr(0, parts.fraction.find_last_not_of('0') + 1);
+            if(parts.integer.empty() && parts.fraction.empty())
+            {
+                parts.negative = false;
+            }
+            return true;
+        }
+    }
+
+
+    /**
+     * Detects if a string is a decimal number of any length: an optional sign, digits, and optionally a '.' followed
+     * by more digits, e.g. "-123456789012345678901234567890.000001". Unlike isNumber(), nothing is converted, so the
+     * number may be too large or too precise for any built-in type.
+     *
+     * @param str - The string to check.
+     * @param allowFraction - Whether a fractional part is accepted. If false, only integers are.
+     *
+     * @retval bool - true if str is a decimal number, false otherwise.
+     */
+    bool isDecimalString(   std::string_view str,
+                            bool allowFraction = true   )
+    {
+        detail::DecimalParts parts;
+        return detail::splitDecimal(str, parts, allowFraction);
+    }
+
+
+    /**
+     * Compares the values of two decimal strings, as isDecimalString() accepts them, without converting or
+     * allocating. Leading and trailing zeros do not matter, so "007.50" equals "7.5", and "-0" equals "0".
+     *
+     * Throws std::invalid_argument if either string is not a decimal number.
+     *
+     * @param a - The first number.
+     * @param b - The second number.
+     *
+     * @retval std::strong_ordering - How the value of a compares to the value of b.
+     */
+    std::strong_ordering compareNumericStrings(     std::string_view a,
+                                                    std::string_view b  )
+    {
+        detail::DecimalParts x;
+        detail::DecimalParts y;
+        if(!detail::splitDecimal(a, x) || !detail::splitDecimal(b, y))
+        {
+            throw std::invalid_argument("compareNumericStrings(): both strings must be decimal numbers");
+        }
+        if(x.negative != y.negative)
+        {
+            return x.negative ? std::strong_ordering::less : std::strong_ordering::greater;
+        }
+
+        //Without leading zeros, a longer integer part is larger; equal lengths compare digit by digit, and so do the
+        //fractional parts, where the one with digits left over is larger since trailing zeros are gone
+        std::strong_ordering magnitude = x.integer.size() <=> y.integer.size();
+        if(magnitude == 0)
+        {
+            magnitude = x.integer.compare(y.integer) <=> 0;
+        }
+        if(magnitude == 0)
+        {
+            magnitude = x.fraction.compare(y.fraction) <=> 0;
+        }
+        return x.negative ? 0 <=> magnitude : magnitude;
+    }
+
+
+    /**
+     * An exact decimal number of any size and precision, stored as an integer in base 10^9 limbs along with the number
+     * of its digits that are fractional (its scale). Sums keep the larger scale of their operands, so
+     * BigDecimal("1.50") + BigDecimal("0.2") is "1.70", while comparisons ignore the scale.
+     *
+     * Throws std::invalid_argument if constructed from a string that is not a decimal number.
+     */
+    class BigDecimal
+    {
+    public:
+        BigDecimal() = default;
+
+        explicit BigDecimal( std::string_view str )
+        {
+            detail::DecimalParts parts;
+            if(!detail::splitDecimal(str, parts))
+            {
+                throw std::invalid_argument("BigDecimal(): \"" + std::string(str) + "\" is not a decimal number");
+            }
+            //The scale follows the string, trailing zeros included
+            const std::size_t point = str.find('.');
+            m_scale = (point == std::string_view::npos) ? 0 : str.size() - point - 1;
+            m_negative = parts.negative;
+
+            //Read the digits from the right, 9 to a limb, skipping the point
+            const std::size_t digitsBegin = (str.front() == '-') || (str.front() == '+');
+            std::uint32_t limb = 0;
+            std::uint32_t power = 1;
+            for(std::size_t i = str.size(); i-- > digitsBegin;)
+            {
+                if(str[i] == '.')
+                {
+                    continue;
+                }
+                limb += (str[i] - '0') * power;
+                power *= 10;
+                if(power == limbBase)
+                {
+                    m_limbs.push_back(limb);
+                    limb = 0;
+                    power = 1;
+                }
+            }
+            m_limbs.push_back(limb);
+            trim();
+        }
+
+        /**
+         * Returns the number in decimal, with exactly scale() fractional digits.
+         */
+        std::string toString() const
+        {
+            std::string digits = m_limbs.empty() ? "0" : std::to_string(m_limbs.back());
+            for(std::size_t i = m_limbs.size() - std::min<std::size_t>(m_limbs.size(), 1); i-- > 0;)
+            {
+                const std::string limb = std::to_string(m_limbs[i]);
+                digits.append(9 - limb.size(), '0');
+                digits += limb;
+            }
+            if(digits.size() <= m_scale)
+            {
+                digits.insert(0, m_scale + 1 - digits.size(), '0');
+            }
+            if(m_scale != 0)
+            {
+                digits.insert(digits.size() - m_scale, 1, '.');
+            }
+            return m_negative ? "-" + digits : digits;
+        }
+
+        std::size_t scale() const
+        {
+            return m_scale;
+        }
+
+        bool isNegative() const
+        {
+            return m_negative;
+        }
+
+        BigDecimal operator-() const
+        {
+            BigDecimal negated = *this;
+            negated.m_negative = !m_limbs.empty() && !m_negative;
+            return negated;
+        }
+
+        friend BigDecimal operator+(    const BigDecimal & a,
+                                        const BigDecimal & b    )
+        {
+            const std::size_t scale = std::max(a.m_scale, b.m_scale);
+            BigDecimal sum = a.withScale(scale);
+            const BigDecimal addend = b.withScale(scale);
+            if(sum.m_negative == addend.m_negative)
+            {
+                addMagnitudes(sum.m_limbs, addend.m_limbs);
+            }
+            else if(compareMagnitudes(sum.m_limbs, addend.m_limbs) >= 0)
+            {
+                subtractMagnitudes(sum.m_limbs, addend.m_limbs);
+            }
+            else
+            {
+                std::vector<std::uint32_t> difference = addend.m_limbs;
+                subtractMagnitudes(difference, sum.m_limbs);
+                sum.m_limbs = std::move(difference);
+                sum.m_negative = addend.m_negative;
+            }
+            sum.trim();
+            return sum;
+        }
+
+        friend BigDecimal operator-(    const BigDecimal & a,
+                                        const BigDecimal & b    )
+        {
+            return a + (-b);
+        }
+
+        friend std::strong_ordering operator<=>(    const BigDecimal & a,
+                                                    const BigDecimal & b    )
+        {
+            if(a.m_negative != b.m_negative)
+            {
+                return a.m_negative ? std::strong_ordering::less : std::strong_ordering::greater;
+            }
+            const std::size_t scale = std::max(a.m_scale, b.m_scale);
+            const std::strong_ordering magnitude = compareMagnitudes(a.withScale(scale).m_limbs, b.withScale(scale).m_limbs) <=> 0;
+            return a.m_negative ? 0 <=> magnitude : magnitude;
+        }
+
+        friend bool operator==(     const BigDecimal & a,
+                                    const BigDecimal & b    )
+        {
+            return (a <=> b) == 0;
+        }
+
+    private:
+        static constexpr std::uint32_t limbBase = 1000000000;
+
+        /**
+         * Returns the same value with more fractional digits, by multiplying the limbs by a power of ten: whole limbs
+         * for each 9 digits, then a single multiplication for the rest.
+         */
+        BigDecimal withScale( std::size_t scale ) const
+        {
+            BigDecimal scaled = *this;
+            scaled.m_scale = scale;
+            if(m_limbs.empty() || (scale == m_scale))
+            {
+                return scaled;
+            }
+            const std::size_t digits = scale - m_scale;
+            scaled.m_limbs.insert(scaled.m_limbs.begin(), digits / 9, 0);
+            const std::uint64_t factor = detail::powersOf10[digits % 9];
+            std::uint64_t carry = 0;
+            for(std::uint32_t & limb : scaled.m_limbs)
+            {
+                const std::uint64_t product = limb * factor + carry;
+                limb = static_cast<std::uint32_t>(product % limbBase);
+                carry = product / limbBase;
+            }
+            if(carry != 0)
+            {
+                scaled.m_limbs.push_back(static_cast<std::uint32_t>(carry));
+            }
+            return scaled;
+        }
+
+        static int compareMagnitudes(   const std::vector<std::uint32_t> & a,
+                                        const std::vector<std::uint32_t> & b    )
+        {
+            if(a.size() != b.size())
+            {
+                return (a.size() < b.size()) ? -1 : 1;
+            }
+            for(std::size_t i = a.size(); i-- > 0;)
+            {
+                if(a[i] != b[i])
+                {
+                    return (a[i] < b[i]) ? -1 : 1;
+                }
+            }
+            return 0;
+        }
+
+        static void addMagnitudes(  std::vector<std::uint32_t> & a,
+                                    const std::vector<std::uint32_t> & b    )
+        {
+            a.resize(std::max(a.size(), b.size()), 0);
+            std::uint32_t carry = 0;
+            for(std::size_t i = 0; i < a.size(); ++i)
+            {
+                std::uint32_t limb = a[i] + carry + ((i < b.size()) ? b[i] : 0);
+                carry = (limb >= limbBase);
+                a[i] = carry ? limb - limbBase : limb;
+            }
+            if(carry != 0)
+            {
+                a.push_back(carry);
+            }
+        }
+
+        /**
+         * Subtracts b from a, where a is at least b.
+         */
+        static void subtractMagnitudes(     std::vector<std::uint32_t> & a,
+                                            const std::vector<std::uint32_t> & b    )
+        {
+            std::uint32_t borrow = 0;
+            for(std::size_t i = 0; i < a.size(); ++i)
+            {
+                const std::uint32_t subtrahend = borrow + ((i < b.size()) ? b[i] : 0);
+                borrow = (a[i] < subtrahend);
+                a[i] = a[i] + (borrow ? limbBase : 0) - subtrahend;
+            }
+        }
+
+        /**
+         * Removes the high zero limbs, so that zero has no limbs and no sign.
+         */
+        void trim()
+        {
+            while(!m_limbs.empty() && (m_limbs.back() == 0))
+            {
+                m_limbs.pop_back();
+            }
+            if(m_limbs.empty())
+            {
+                m_negative = false;
+            }
+        }
+
+        //Least significant limb first
+        std::vector<std::uint32_t> m_limbs;
+        std::size_t m_scale = 0;
+        bool m_negative = false;
+    };
+
+
+    /**
+     * Compares two strings in natural ("human") order: runs of digits compare by their numeric value, so "file9" comes
+     * before "file10", and everything else compares byte by byte. Digit runs of any length are compared without
+     * converting them, and nothing is allocated, so it is cheap enough to call from inside std::sort().
+     *
+     * Strings that only differ by leading zeros ("a01" and "a1"), or by case when ignoring it, are finally ordered
+     * byte by byte, so that only equal strings compare equal.
+     *
+     * @param a - The first string.
+     * @param b - The second string.
+     * @param ignoreCase - Whether ASCII letters compare regardless of case.
+     *
+     * @retval std::strong_ordering - How a compares to b in natural order.
+     */
+    std::strong_ordering naturalCompare(    std::string_view a,
+                                            std::string_view b,
+                                            bool ignoreCase = false )
+    {
+        const char * p = a.data();
+        const char * q = b.data();
+        const char * const aEnd = p + a.size();
+        const char * const bEnd = q + b.size();
+        while((p != aEnd) && (q != bEnd))
+        {
+            if(detail::isDigit(*p) && detail::isDigit(*q))
+            {
+                //Without their leading zeros, a longer run is a larger number, and runs of equal length compare like
+                //strings
+                while((p != aEnd) && (*p == '0'))
+                {
+                    ++p;
+                }
+                while((q != bEnd) && (*q == '0'))
+                {
+                    ++q;
+                }
+                const char * const aRunEnd = detail::skipDigits(p, aEnd);
+                const char * const bRunEnd = detail::skipDigits(q, bEnd);
+                if(aRunEnd - p != bRunEnd - q)
+                {
+                    return (aRunEnd - p) <=> (bRunEnd - q);
+                }
+                const int digits = std::memcmp(p, q, aRunEnd - p);
+                if(digits != 0)
+                {
+                    return digits <=> 0;
+                }
+                p = aRunEnd;
+                q = bRunEnd;
+                continue;
+            }
+            unsigned char x = static_cast<unsigned char>(*p);
+            unsigned char y = static_cast<unsigned char>(*q);
+            if(ignoreCase)
+            {
+                x = detail::charClassTable.lower[x];
+                y = detail::charClassTable.lower[y];
+            }
+            if(x != y)
+            {
+                return x <=> y;
+            }
+            ++p;
+            ++q;
+        }
+        if((p != aEnd) || (q != bEnd))
+        {
+            return (p != aEnd) ? std::strong_ordering::greater : std::strong_ordering::less;
+        }
+        return a <=> b;
+    }
+
+
+    /**
+     * A function object ordering strings with naturalCompare(), for std::sort() and ordered containers.
+     */
+    struct NaturalLess
+    {
+        bool ignoreCase = false;
+
+        bool operator()(    std::string_view a,
+                            std::string_view b  ) const
+        {
+            return naturalCompare(a, b, ignoreCase) < 0;
+        }
+    };
+
+
+    /**
+     * Builds a key whose plain byte order is the natural order of the strings: the keys of a and b compare like
+     * naturalCompare(a, b, ignoreCase). Building the keys once and sorting them with memcmp is faster than calling
+     * naturalCompare() for each comparison of a large sort.
+     *
+     * Each digit run becomes a '0' marker, the 4-byte big-endian length of the run without its leading zeros, and its
+     * significant digits. Other bytes are copied, with 0x00 and 0x01 escaped as 0x01 0x01 and 0x01 0x02 so that the
+     * 0x00 separating the key from the original string, used to break ties, sorts before anything else.
+     *
+     * @param str - The string to build the key for.
+     * @param ignoreCase - Whether ASCII letters are lowered in the key.
+     *
+     * @retval std::string - The sort key of str.
+     */
+    std::string naturalSortKey(     std::string_view str,
+                                    bool ignoreCase = false )
+    {
+        std::string key;
+        key.reserve(2 * str.size() + 8);
+        const char * p = str.data();
+        const char * const end = p + str.size();
+        while(p != end)
+        {
+            if(detail::isDigit(*p))
+            {
+                while((p != end) && (*p == '0'))
+                {
+                    ++p;
+                }
+                const char * const runEnd = detail::skipDigits(p, end);
+                const std::uint32_t length = static_cast<std::uint32_t>(runEnd - p);
+                const char header[5] = {    '0',
+                                            static_cast<char>(length >> 24), static_cast<char>(length >> 16),
+                                            static_cast<char>(length >> 8), static_cast<char>(length)   };
+                key.append(header, 5);
+                key.append(p, runEnd);
+                p = runEnd;
+                continue;
+            }
+            unsigned char c = static_cast<unsigned char>(*p++);
+            if(ignoreCase)
+            {
+                c = detail::charClassTable.lower[c];
+            }
+            if(c <= 1)
+            {
+                key += '\x01';
+                ++c;
+            }
+            key += static_cast<char>(c);
+        }
+        key += '\0';
+        key.append(str);
+        return key;
+    }
+
+
+    /**
+     * Sorts strings in natural order. A sort key is built once per string with naturalSortKey(), the keys are sorted,
+     * and the strings are then moved to their place, so each comparison is a plain memcmp.
+     *
+     * @param strings - The strings to sort in place.
+     * @param ignoreCase - Whether ASCII letters compare regardless of case.
+     */
+    void naturalSort(   std::span<std::string> strings,
+                        bool ignoreCase = false )
+    {
+        std::vector<std::pair<std::string, std::size_t>> keys(strings.size());
+        for(std::size_t i = 0; i < strings.size(); ++i)
+        {
+            keys[i] = {naturalSortKey(strings[i], ignoreCase), i};
+        }
+        std::sort(keys.begin(), keys.end());
+
+        std::vector<std::string> sorted(strings.size());
+        for(std::size_t i = 0; i < keys.size(); ++i)
+        {
+            sorted[i] = std::move(strings[keys[i].second]);
+        }
+        std::move(sorted.begin(), sorted.end(), strings.begin());
+    }
+
+
+    /**
+     * Reverses the order of a string's characters using std::reverse().
+     *
+     * Parameter:
+     *  std::string & str - The string we would like to reverse.
+     *
+     * Returns:
+     *  std::string - The reversed string.
+    */
+    std::string reverse( std::string str )
+    {
+        std::reverse(str.begin(),str.end());
+        return str;
+    }
+
+
+    /**
+     * Options for isPalindrome(). They can be combined with operator|, e.g.
+     * PalindromePolicy::ignoreCase | PalindromePolicy::ignoreNonAlphanumeric to accept "A man, a plan, a canal, panama".
+     * Case folding and the alphanumeric classification only consider ASCII characters.
+     */
+    enum class PalindromePolicy : unsigned
+    {
+        strict = 0,
+        ignoreCase = 1 << 0,
+        ignoreNonAlphanumeric = 1 << 1
+    };
+
+    constexpr PalindromePolicy operator|(   PalindromePolicy a,
+                                            PalindromePolicy b  )
+    {
+        return static_cast<PalindromePolicy>(static_cast<unsigned>(a) | static_cast<unsigned>(b));
+    }
+
+    constexpr bool operator&(   PalindromePolicy a,
+                                PalindromePolicy b  )
+    {
+        return (static_cast<unsigned>(a) & static_cast<unsigned>(b)) != 0;
+    }
+
+
+    namespace detail
+    {
+#ifdef STEVENSSTRINGLIB_X86_64
+        /**
+         * Compares str[i..i+32) with the reversal of str[j-32..j) while the two blocks do not overlap, and returns the
+         * number of bytes matched on each side, or std::string_view::npos on mismatch.
+         */
+        __attribute__((target("avx2")))
+        std::size_t matchPalindromeBlocksAvx2( std::string_view str )
+        {
+            //Reverses the bytes in each 128-bit lane; the lanes are then swapped with a permutation
+            const __m256i reverseBytes = _mm256_setr_epi8(  15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+                                                            15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0    );
+            const char * const data = str.data();
+            std::size_t i = 0;
+            std::size_t j = str.size();
+            while(i + 64 <= j)
+            {
+                const __m256i front = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+                const __m256i back = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + j - 32));
+                const __m256i reversedBack = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(back, reverseBytes), 0x4E);
+                if(_mm256_movemask_epi8(_mm256_cmpeq_epi8(front, reversedBack)) != -1)
+                {
+                    return std::string_view::npos;
+                }
+                i += 32;
+                j -= 32;
+            }
+            return i;
+        }
+#endif
+    }
+
+
+    /**
+     * Checks to see if a string is a palindrome according to a policy. With PalindromePolicy::ignoreNonAlphanumeric,
+     * spaces and punctuation are skipped, and with PalindromePolicy::ignoreCase letters are compared case-insensitively,
+     * so phrases like "Go hang a salami, I'm a lasagna hog!" can be checked without first copying the string through
+     * removeWhitespace() and a case conversion. Two indices walk inward from both ends and no memory is allocated.
+     *
+     * The strict policy compares 32-byte blocks from each end at once on CPUs supporting AVX2.
+     *
+     * @param str - The string we would like to check.
+     * @param policy - Which differences between the two halves are tolerated.
+     *
+     * @retval bool - true if str is a palindrome under policy, false otherwise.
+     */
+    bool isPalindrome(  std::string_view str,
+                        PalindromePolicy policy )
+    {
+        std::size_t i = 0;
+        std::size_t j = str.size();
+
+        if(policy == PalindromePolicy::strict)
+        {
+#ifdef STEVENSSTRINGLIB_X86_64
+            if(detail::cpuHasAvx2())
+            {
+                i = detail::matchPalindromeBlocksAvx2(str);
+                if(i == std::string_view::npos)
+                {
+                    return false;
+                }
+                j -= i;
+            }
+#endif
+            return std::equal(str.begin() + i, str.begin() + i + (j - i)/2, str.rbegin() + i);
+        }
+
+        const bool ignoreCase = policy & PalindromePolicy::ignoreCase;
+        const bool skipNonAlphanumeric = policy & PalindromePolicy::ignoreNonAlphanumeric;
+        const unsigned char * const data = reinterpret_cast<const unsigned char *>(str.data());
+        while(true)
+        {
+            if(skipNonAlphanumeric)
+            {
+                while((i < j) && !detail::charClassTable.alphanumeric[data[i]])
+                {
+                    ++i;
+                }
+                while((i < j) && !detail::charClassTable.alphanumeric[data[j - 1]])
+                {
+                    --j;
+                }
+            }
+            if(j - i < 2)
+            {
+                return true;
+            }
+
+            unsigned char front = data[i];
+            unsigned char back = data[j - 1];
+            if(ignoreCase)
+            {
+                front = detail::charClassTable.lower[front];
+                back = detail::charClassTable.lower[back];
+            }
+            if(front != back)
+            {
+                return false;
+            }
+            ++i;
+            --j;
+        }
+    }
+
+
+    /**
+     * Checks to see if a std::string is a palindrime or not (the reversed order of characters equals the original order of characters).
+     * Note well that character case, spacing, and punctuation present in classic English palindromes like "A man, a plan, a canal, panama"
+     * prevent them from being valid C++ palindromes with this function, as the reverse order of this exact string is "amanap ,lanac a ,nalp a ,nam A" is
+     * not equivalent to the original order of characters.
+     *
+     * Credit: https://stackoverflow.com/a/8362657/16511184
+     *
+     * Parameter:
+     *  std::string str - The string we would like to check.
+     *
+     * Returns:
+     *  bool - true if str is a palindrome, false otherwise.
+    */
+    bool isPalindrome( const std::string & str )
+    {
+        return isPalindrome(str, PalindromePolicy::strict);
+    }
+
+
+    namespace detail
+    {
+        /**
+         * Manacher's algorithm. After the call, odd[i] is the number of odd-length palindromes centered on str[i] (so
+         * the longest one has length 2*odd[i] - 1), and even[i] is the number of even-length palindromes centered
+         * between str[i-1] and str[i]. Runs in linear time. Radius is an unsigned type large enough to hold
+         * str.size().
+         */
+        template<typename Radius>
+        void palindromeRadii(   std::string_view str,
+                                std::vector<Radius> & odd,
+                                std::vector<Radius> & even  )
+        {
+            const std::ptrdiff_t n = str.size();
+            odd.assign(n, 0);
+            even.assign(n, 0);
+
+            //[left, right] is the rightmost palindrome found so far
+            std::ptrdiff_t left = 0;
+            std::ptrdiff_t right = -1;
+            for(std::ptrdiff_t i = 0; i < n; ++i)
+            {
+                std::ptrdiff_t k = (i > right) ? 1 : std::min<std::ptrdiff_t>(odd[left + right - i], right - i + 1);
+                while((i - k >= 0) && (i + k < n) && (str[i - k] == str[i + k]))
+                {
+                    ++k;
+                }
+                odd[i] = static_cast<Radius>(k);
+                if(i + k - 1 > right)
+                {
+                    left = i - k + 1;
+                    right = i + k - 1;
+                }
+            }
+
+            left = 0;
+            right = -1;
+            for(std::ptrdiff_t i = 0; i < n; ++i)
+            {
+                std::ptrdiff_t k = (i > right) ? 0 : std::min<std::ptrdiff_t>(even[left + right - i + 1], right - i + 1);
+                while((i - k - 1 >= 0) && (i + k < n) && (str[i - k - 1] == str[i + k]))
+                {
+                    ++k;
+                }
+                even[i] = static_cast<Radius>(k);
+                if(i + k - 1 > right)
+                {
+                    left = i - k;
+                    right = i + k - 1;
+                }
+            }
+        }
+
+
+        /**
+         * Computes the palindrome radii of str with the smallest integer type able to hold them (16, 32 or 64 bits),
+         * then calls function(odd, even) and returns its result.
+         */
+        template<typename Function>
+        auto withPalindromeRadii(   std::string_view str,
+                                    Function && function    )
+        {
+            if(str.size() <= std::numeric_limits<std::uint16_t>::max())
+            {
+                std::vector<std::uint16_t> odd;
+                std::vector<std::uint16_t> even;
+                palindromeRadii(str, odd, even);
+                return function(odd, even);
+            }
+            if(str.size() <= std::numeric_limits<std::uint32_t>::max())
+            {
+                std::vector<std::uint32_t> odd;
+                std::vector<std::uint32_t> even;
+                palindromeRadii(str, odd, even);
+                return function(odd, even);
+            }
+            std::vector<std::uint64_t> odd;
+            std::vector<std::uint64_t> even;
+            palindromeRadii(str, odd, even);
+            return function(odd, even);
+        }
+    }
+
+
+    /**
+     * Finds the longest palindromic substring of a string in linear time, using Manacher's algorithm. When several
+     * palindromes have the maximal length, the leftmost one is returned.
+     *
+     * Example: longestPalindromicSubstring("I saw a racecar today") returns " racecar ".
+     *
+     * @param str - The string to search.
+     *
+     * @retval std::string_view - A view of the longest palindrome in str, empty only if str is empty.
+     */
+    std::string_view longestPalindromicSubstring( std::string_view str )
+    {
+        return detail::withPalindromeRadii(str, [str](const auto & odd, const auto & even)
+        {
+            std::size_t bestStart = 0;
+            std::size_t bestLength = 0;
+            for(std::size_t i = 0; i < str.size(); ++i)
+            {
+                const std::size_t oddLength = 2 * std::size_t(odd[i]) - 1;
+                const std::size_t oddStart = i + 1 - odd[i];
+                if((oddLength > bestLength) || ((oddLength == bestLength) && (oddStart < bestStart)))
+                {
+                    bestLength = oddLength;
+                    bestStart = oddStart;
+                }
+                const std::size_t evenLength = 2 * std::size_t(even[i]);
+                const std::size_t evenStart = i - even[i];
+                if((evenLength > bestLength) || ((evenLength == bestLength) && (evenStart < bestStart)))
+                {
+                    bestLength = evenLength;
+                    bestStart = evenStart;
+                }
+            }
+            return str.substr(bestStart, bestLength);
+        });
+    }
+
+
+    /**
+     * Counts the palindromic substrings of a string in linear time, using Manacher's algorithm. Every occurrence is
+     * counted, including the single characters: "aaa" has 6 palindromic substrings ("a" three times, "aa" twice and
+     * "aaa").
+     *
+     * @param str - The string whose palindromic substrings we want to count.
+     *
+     * @retval std::uint64_t - The number of non-empty palindromic substrings of str.
+     */
+    std::uint64_t countPalindromicSubstrings( std::string_view str )
+    {
+        return detail::withPalindromeRadii(str, [](const auto & odd, const auto & even)
+        {
+            std::uint64_t count = 0;
+            for(std::size_t i = 0; i < odd.size(); ++i)
+            {
+                count += odd[i];
+                count += even[i];
+            }
+            return count;
+        });
+    }
+
+
+    /**
+     * Enumerates the maximal palindromes of a string: for each center (a character, or the gap between two characters)
+     * the longest palindrome around it, when it is at least minLength characters long. Every palindromic substring of
+     * str is contained in one of them, sharing its center. Results are ordered by center.
+     *
+     * @param str - The string to search.
+     * @param minLength - The length under which palindromes are not reported.
+     *
+     * @retval std::vector<std::string_view> - Views of the maximal palindromes of str.
+     */
+    std::vector<std::string_view> findMaximalPalindromes(   std::string_view str,
+                                                            std::size_t minLength = 2   )
+    {
+        return detail::withPalindromeRadii(str, [str, minLength](const auto & odd, const auto & even)
+        {
+            std::vector<std::string_view> palindromes;
+            for(std::size_t i = 0; i < str.size(); ++i)
+            {
+                const std::size_t evenLength = 2 * std::size_t(even[i]);
+                if((evenLength != 0) && (evenLength >= minLength))
+                {
+                    palindromes.push_back(str.substr(i - even[i], evenLength));
+                }
+                const std::size_t oddLength = 2 * std::size_t(odd[i]) - 1;
+                if(oddLength >= minLength)
+                {
+                    palindromes.push_back(str.substr(i + 1 - odd[i], oddLength));
+                }
+            }
+            return palindromes;
+        });
+    }
+
+
+    namespace detail
+    {
+        /**
+         * Scalar UTF-8 validation, following the table of well-formed byte sequences from the Unicode standard
+         * (Table 3-7). Runs of ASCII are skipped 8 bytes at a time.
+         */
+        bool isValidUtf8Scalar( const unsigned char * data,
+                                std::size_t length  )
+        {
+            std::size_t i = 0;
+            while(i < length)
+            {
+                if((i + 8 <= length) && ((load64(data + i) & 0x8080808080808080ULL) == 0))
+                {
+                    i += 8;
+                    continue;
+                }
+
+                const unsigned char byte = data[i];
+                if(byte < 0x80)
+                {
+                    ++i;
+                    continue;
+                }
+
+                //Number of continuation bytes expected, and the range allowed for the first of them
+                std::size_t needed;
+                unsigned char low = 0x80;
+                unsigned char high = 0xBF;
+                if((byte >= 0xC2) && (byte <= 0xDF))
+                {
+                    needed = 1;
+                }
+                else if(byte == 0xE0)
+                {
+                    needed = 2;
+                    low = 0xA0;
+                }
+                else if(byte == 0xED)
+                {
+                    needed = 2;
+                    high = 0x9F;
+                }
+                else if((byte >= 0xE1) && (byte <= 0xEF))
+                {
+                    needed = 2;
+                }
+                else if(byte == 0xF0)
+                {
+                    needed = 3;
+                    low = 0x90;
+                }
+                else if((byte >= 0xF1) && (byte <= 0xF3))
+                {
+                    needed = 3;
+                }
+                else if(byte == 0xF4)
+                {
+                    needed = 3;
+                    high = 0x8F;
+                }
+                else
+                {
+                    return false;
+                }
+
+                if(length - i <= needed)
+                {
+                    return false;
+                }
+                if((data[i + 1] < low) || (data[i + 1] > high))
+                {
+                    return false;
+                }
+                for(std::size_t k = 2; k <= needed; ++k)
+                {
+                    if((data[i + k] & 0xC0) != 0x80)
+                    {
+                        return false;
+                    }
+                }
+                i += needed + 1;
+            }
+            return true;
+        }
+
+
+        /**
+         * Scalar count of the code points of a UTF-8 string, i.e. the number of bytes that are not continuation bytes.
+         */
+        std::size_t countCodePointsScalar(  const unsigned char * data,
+                                            std::size_t length  )
+        {
+            std::size_t count = 0;
+            for(std::size_t i = 0; i < length; ++i)
+            {
+                count += ((data[i] & 0xC0) != 0x80);
+            }
+            return count;
+        }
+
+
+#ifdef STEVENSSTRINGLIB_X86_64
+        /**
+         * Processes one block of 32 bytes for the AVX2 UTF-8 validator. This is the lookup algorithm from Keiser and
+         * Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte": the high and low nibbles of each byte and the
+         * high nibble of the next one index three tables of error flags, and a byte pair is invalid when the three flags
+         * share a bit. Three and four byte sequences are then checked by verifying that the continuation bytes are
+         * exactly where the lead bytes expect them.
+         */
+        __attribute__((target("avx2")))
+        void checkUtf8BlockAvx2(    __m256i input,
+                                    __m256i & previousInput,
+                                    __m256i & previousIncomplete,
+                                    __m256i & error  )
+        {
+            if(_mm256_movemask_epi8(input) == 0)
+            {
+                //All ASCII: the only possible error is a sequence left unfinished by the previous block
+                error = _mm256_or_si256(error, previousIncomplete);
+                previousInput = input;
+                previousIncomplete = _mm256_setzero_si256();
+                return;
+            }
+
+            constexpr unsigned char tooShort = 1 << 0;
+            constexpr unsigned char tooLong = 1 << 1;
+            constexpr unsigned char overlong3 = 1 << 2;
+            constexpr unsigned char tooLarge = 1 << 3;
+            constexpr unsigned char surrogate = 1 << 4;
+            constexpr unsigned char overlong2 = 1 << 5;
+            constexpr unsigned char tooLarge1000 = 1 << 6;
+            constexpr unsigned char overlong4 = 1 << 6;
+            constexpr unsigned char twoConts = 1 << 7;
+            constexpr unsigned char carry = tooShort | tooLong | twoConts;
+
+            alignas(16) static constexpr unsigned char byte1HighTable[16] = {
+                tooLong, tooLong, tooLong, tooLong, tooLong, tooLong, tooLong, tooLong,
+                twoConts, twoConts, twoConts, twoConts,
+                tooShort | overlong2,
+                tooShort,
+                tooShort | overlong3 | surrogate,
+                tooShort | tooLarge | tooLarge1000 | overlong4 };
+            alignas(16) static constexpr unsigned char byte1LowTable[16] = {
+                carry | overlong3 | overlong2 | overlong4,
+                carry | overlong2,
+                carry,
+                carry,
+                carry | tooLarge,
+                carry | tooLarge | tooLarge1000,
+                carry | tooLarge | tooLarge1000,
+                carry | tooLarge | tooLarge1000,
+                carry | tooLarge | tooLarge1000,
+                carry | tooLarge | tooLarge1000,
+                carry | tooLarge | tooLarge1000,
+                carry | tooLarge | tooLarge1000,
+                carry | tooLarge | tooLarge1000,
+                carry | tooLarge | tooLarge1000 | surrogate,
+                carry | tooLarge | tooLarge1000,
+                carry | tooLarge | tooLarge1000 };
+            alignas(16) static constexpr unsigned char byte2HighTable[16] = {
+                tooShort, tooShort, tooShort, tooShort, tooShort, tooShort, tooShort, tooShort,
+                tooLong | overlong2 | twoConts | overlong3 | tooLarge1000 | overlong4,
+                tooLong | overlong2 | twoConts | overlong3 | tooLarge,
+                tooLong | overlong2 | twoConts | surrogate | tooLarge,
+                tooLong | overlong2 | twoConts | surrogate | tooLarge,
+                tooShort, tooShort, tooShort, tooShort };
+
+            const __m256i lowNibbleMask = _mm256_set1_epi8(0x0F);
+            const __m256i byte1High = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(byte1HighTable)));
+            const __m256i byte1Low = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(byte1LowTable)));
+            const __m256i byte2High = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(byte2HighTable)));
+
+            //The bytes preceding each byte of input by 1, 2 and 3 positions, taken across the block boundary
+            const __m256i straddle = _mm256_permute2x128_si256(previousInput, input, 0x21);
+            const __m256i prev1 = _mm256_alignr_epi8(input, straddle, 15);
+            const __m256i prev2 = _mm256_alignr_epi8(input, straddle, 14);
+            const __m256i prev3 = _mm256_alignr_epi8(input, straddle, 13);
+
+            const __m256i prev1High = _mm256_and_si256(_mm256_srli_epi16(prev1, 4), lowNibbleMask);
+            const __m256i prev1Low = _mm256_and_si256(prev1, lowNibbleMask);
+            const __m256i inputHigh = _mm256_and_si256(_mm256_srli_epi16(input, 4), lowNibbleMask);
+            const __m256i specialCases = _mm256_and_si256(  _mm256_and_si256(   _mm256_shuffle_epi8(byte1High, prev1High),
+                                                                                _mm256_shuffle_epi8(byte1Low, prev1Low) ),
+                                                            _mm256_shuffle_epi8(byte2High, inputHigh)   );
+
+            //Bytes two and three positions after a three or four byte lead must be continuation bytes
+            const __m256i isThirdByte = _mm256_subs_epu8(prev2, _mm256_set1_epi8(0xE0 - 0x80));
+            const __m256i isFourthByte = _mm256_subs_epu8(prev3, _mm256_set1_epi8(0xF0 - 0x80));
+            const __m256i mustBeContinuation = _mm256_and_si256(    _mm256_or_si256(isThirdByte, isFourthByte),
+                                                                    _mm256_set1_epi8(static_cast<char>(0x80))   );
+            error = _mm256_or_si256(error, _mm256_xor_si256(mustBeContinuation, specialCases));
+
+            //A lead byte in the last three positions needs continuation bytes from the next block
+            const __m256i maxValue = _mm256_setr_epi8(  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                                        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                                        static_cast<char>(0xF0 - 1),
+                                                        static_cast<char>(0xE0 - 1),
+                                                        static_cast<char>(0xC0 - 1)    );
+            previousIncomplete = _mm256_subs_epu8(input, maxValue);
+            previousInput = input;
+        }
+
+
+        /**
+         * AVX2 UTF-8 validation, processing 32 bytes per iteration. See checkUtf8BlockAvx2().
+         */
+        __attribute__((target("avx2")))
+        bool isValidUtf8Avx2(   const unsigned char * data,
+                                std::size_t length  )
+        {
+            __m256i previousInput = _mm256_setzero_si256();
+            __m256i previousIncomplete = _mm256_setzero_si256();
+            __m256i error = _mm256_setzero_si256();
+
+            std::size_t i = 0;
+            for(; i + 32 <= length; i += 32)
+            {
+                const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+                checkUtf8BlockAvx2(input, previousInput, previousIncomplete, error);
+            }
+            if(i < length)
+            {
+                //The tail is padded with zeros, which are ASCII and thus terminate any valid sequence
+                alignas(32) unsigned char tail[32] = {};
+                std::memcpy(tail, data + i, length - i);
+                checkUtf8BlockAvx2(_mm256_load_si256(reinterpret_cast<const __m256i *>(tail)), previousInput, previousIncomplete, error);
+            }
+            error = _mm256_or_si256(error, previousIncomplete);
+
+            return _mm256_testz_si256(error, error);
+        }
+
+
+        /**
+         * AVX2 count of the code points of a UTF-8 string. Continuation bytes are the ones in [0x80, 0xBF], i.e. the
+         * signed bytes lower than or equal to -65.
+         */
+        __attribute__((target("avx2")))
+        std::size_t countCodePointsAvx2(    const unsigned char * data,
+                                            std::size_t length  )
+        {
+            const __m256i threshold = _mm256_set1_epi8(-65);
+            std::size_t count = 0;
+            std::size_t i = 0;
+            for(; i + 32 <= length; i += 32)
+            {
+                const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+                const unsigned int leadBytes = _mm256_movemask_epi8(_mm256_cmpgt_epi8(input, threshold));
+                count += std::popcount(leadBytes);
+            }
+            return count + countCodePointsScalar(data + i, length - i);
+        }
+#endif
+
+
+        /**
+         * Decodes the code point starting at p and advances p past it. The input must be valid UTF-8.
+         */
+        char32_t decodeValidUtf8( const unsigned char * & p )
+        {
+            const unsigned char byte = *p++;
+            if(byte < 0x80)
+            {
+                return byte;
+            }
+            if(byte < 0xE0)
+            {
+                return (char32_t(byte & 0x1F) << 6) | (*p++ & 0x3F);
+            }
+            if(byte < 0xF0)
+            {
+                const char32_t codePoint = (char32_t(byte & 0x0F) << 12) | (char32_t(p[0] & 0x3F) << 6) | (p[1] & 0x3F);
+                p += 2;
+                return codePoint;
+            }
+            const char32_t codePoint = (char32_t(byte & 0x07) << 18) | (char32_t(p[0] & 0x3F) << 12)
+                                       | (char32_t(p[1] & 0x3F) << 6) | (p[2] & 0x3F);
+            p += 3;
+            return codePoint;
+        }
+
+
+        /**
+         * Appends the UTF-8 encoding of a code point to a string. The code point must be a Unicode scalar value.
+         */
+        void appendUtf8(    std::string & str,
+                            char32_t codePoint  )
+        {
+            if(codePoint < 0x80)
+            {
+                str += static_cast<char>(codePoint);
+            }
+            else if(codePoint < 0x800)
+            {
+                str += static_cast<char>(0xC0 | (codePoint >> 6));
+                str += static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+            else if(codePoint < 0x10000)
+            {
+                str += static_cast<char>(0xE0 | (codePoint >> 12));
+                str += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                str += static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+            else
+            {
+                str += static_cast<char>(0xF0 | (codePoint >> 18));
+                str += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+                str += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                str += static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+        }
+
+
+        /**
+         * Transcodes valid UTF-8 to a string of 16 or 32 bit code units. ASCII runs are widened 8 bytes at a time.
+         */
+        template<typename CharT>
+        std::basic_string<CharT> decodeValidUtf8String( std::string_view str )
+        {
+            //A code point never needs more code units than it has bytes in UTF-8
+            std::basic_string<CharT> result(str.size(), CharT());
+            CharT * out = result.data();
+
+            const unsigned char * p = reinterpret_cast<const unsigned char *>(str.data());
+            const unsigned char * const end = p + str.size();
+            while(p < end)
+            {
+                if((end - p >= 8) && ((load64(p) & 0x8080808080808080ULL) == 0))
+                {
+                    for(int i = 0; i < 8; ++i)
+                    {
+                        out[i] = p[i];
+                    }
+                    out += 8;
+                    p += 8;
+                    continue;
+                }
+
+                const char32_t codePoint = decodeValidUtf8(p);
+                if((sizeof(CharT) == 2) && (codePoint >= 0x10000))
+                {
+                    *out++ = static_cast<CharT>(0xD800 + ((codePoint - 0x10000) >> 10));
+                    *out++ = static_cast<CharT>(0xDC00 + ((codePoint - 0x10000) & 0x3FF));
+                }
+                else
+                {
+                    *out++ = static_cast<CharT>(codePoint);
+                }
+            }
+            result.resize(out - result.data());
+            return result;
+        }
+    }
+
+
+    /**
+     * Checks whether a string is valid UTF-8: no overlong encodings, no surrogates, no code point above U+10FFFF and no
+     * truncated sequence. On CPUs supporting AVX2 the validation processes 32 bytes at a time, otherwise it falls back to
+     * a scalar implementation.
+     *
+     * @param str - The bytes to validate.
+     *
+     * @retval bool - true if str is valid UTF-8, false otherwise.
+     */
+    bool isValidUtf8( std::string_view str )
+    {
+        const unsigned char * data = reinterpret_cast<const unsigned char *>(str.data());
+#ifdef STEVENSSTRINGLIB_X86_64
+        if(detail::cpuHasAvx2())
+        {
+            return detail::isValidUtf8Avx2(data, str.size());
+        }
+#endif
+        return detail::isValidUtf8Scalar(data, str.size());
+    }
+
+
+    /**
+     * Counts the code points of a UTF-8 string. The string is expected to be valid UTF-8, see isValidUtf8(); otherwise
+     * the result is the number of bytes that are not continuation bytes.
+     *
+     * @param str - The UTF-8 string whose code points we want to count.
+     *
+     * @retval std::size_t - The number of code points in str.
+     */
+    std::size_t countCodePoints( std::string_view str )
+    {
+        const unsigned char * data = reinterpret_cast<const unsigned char *>(str.data());
+#ifdef STEVENSSTRINGLIB_X86_64
+        if(detail::cpuHasAvx2())
+        {
+            return detail::countCodePointsAvx2(data, str.size());
+        }
+#endif
+        return detail::countCodePointsScalar(data, str.size());
+    }
+
+
+    /**
+     * Converts a UTF-8 string to UTF-32.
+     *
+     * Throws std::invalid_argument if str is not valid UTF-8.
+     *
+     * @param str - The UTF-8 string to convert.
+     *
+     * @retval std::u32string - The code points of str.
+     */
+    std::u32string utf8ToUtf32( std::string_view str )
+    {
+        if(!isValidUtf8(str))
+        {
+            throw std::invalid_argument("utf8ToUtf32(): the input is not valid UTF-8");
+        }
+        return detail::decodeValidUtf8String<char32_t>(str);
+    }
+
+
+    /**
+     * Converts a UTF-8 string to UTF-16. Code points above U+FFFF are encoded as surrogate pairs.
+     *
+     * Throws std::invalid_argument if str is not valid UTF-8.
+     *
+     * @param str - The UTF-8 string to convert.
+     *
+     * @retval std::u16string - str encoded in UTF-16.
+     */
+    std::u16string utf8ToUtf16( std::string_view str )
+    {
+        if(!isValidUtf8(str))
+        {
+            throw std::invalid_argument("utf8ToUtf16(): the input is not valid UTF-8");
+        }
+        return detail::decodeValidUtf8String<char16_t>(str);
+    }
+
+
+    /**
+     * Converts a UTF-32 string to UTF-8.
+     *
+     * Throws std::invalid_argument if str contains a surrogate or a value above U+10FFFF.
+     *
+     * @param str - The code points to encode.
+     *
+     * @retval std::string - str encoded in UTF-8.
+     */
+    std::string utf32ToUtf8( std::u32string_view str )
+    {
+        std::string result;
+        result.reserve(str.size());
+        for(const char32_t codePoint : str)
+        {
+            if((codePoint > 0x10FFFF) || ((codePoint >= 0xD800) && (codePoint <= 0xDFFF)))
+            {
+                throw std::invalid_argument("utf32ToUtf8(): the input contains an invalid code point");
+            }
+            detail::appendUtf8(result, codePoint);
+        }
+        return result;
+    }
+
+
+    /**
+     * Converts a UTF-16 string to UTF-8.
+     *
+     * Throws std::invalid_argument if str contains an unpaired surrogate.
+     *
+     * @param str - The UTF-16 string to convert.
+     *
+     * @retval std::string - str encoded in UTF-8.
+     */
+    std::string utf16ToUtf8( std::u16string_view str )
+    {
+        std::string result;
+        result.reserve(str.size());
+        for(std::size_t i = 0; i < str.size(); ++i)
+        {
+            char32_t codePoint = str[i];
+            if((codePoint >= 0xD800) && (codePoint <= 0xDBFF))
+            {
+                if((i + 1 == str.size()) || (str[i + 1] < 0xDC00) || (str[i + 1] > 0xDFFF))
+                {
+                    throw std::invalid_argument("utf16ToUtf8(): the input contains an unpaired surrogate");
+                }
+                codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (str[i + 1] - 0xDC00);
+                ++i;
+            }
+            else if((codePoint >= 0xDC00) && (codePoint <= 0xDFFF))
+            {
+                throw std::invalid_argument("utf16ToUtf8(): the input contains an unpaired surrogate");
+            }
+            detail::appendUtf8(result, codePoint);
+        }
+        return result;
+    }
+
+
+    /**
+     * Checks whether all the bytes of a string are ASCII, by OR-ing the string together 8 bytes at a time and testing the
+     * high bits once at the end.
+     *
+     * @param str - The string to check.
+     *
+     * @retval bool - true if no byte of str has its high bit set.
+     */
+    bool isAscii( std::string_view str )
+    {
+        const char * p = str.data();
+        const std::size_t length = str.size();
+        std::uint64_t bits = 0;
+        std::size_t i = 0;
+        for(; i + 32 <= length; i += 32)
+        {
+            bits |= detail::load64(p + i) | detail::load64(p + i + 8) | detail::load64(p + i + 16) | detail::load64(p + i + 24);
+        }
+        for(; i + 8 <= length; i += 8)
+        {
+            bits |= detail::load64(p + i);
+        }
+        for(; i < length; ++i)
+        {
+            bits |= static_cast<unsigned char>(p[i]);
+        }
+        return (bits & 0x8080808080808080ULL) == 0;
+    }
+
+
+    /**
+     * Reverses the order of a string's bytes in place, without the copy made by reverse().
+     *
+     * @param str - The string we would like to reverse.
+     */
+    void reverseInPlace( std::string & str )
+    {
+        std::reverse(str.begin(), str.end());
+    }
+
+
+    namespace detail
+    {
+        /**
+         * The Grapheme_Cluster_Break property values from Unicode Standard Annex #29, plus Extended_Pictographic which is
+         * needed by the emoji ZWJ sequences rule.
+         */
+        enum class GraphemeBreakProperty : std::uint8_t
+        {
+            other,
+            cr,
+            lf,
+            control,
+            extend,
+            zwj,
+            regionalIndicator,
+            prepend,
+            spacingMark,
+            l,
+            v,
+            t,
+            lv,
+            lvt,
+            //Only used in the table, resolved to lv or lvt from the position of the syllable in the Hangul block
+            lvOrLvt,
+            extendedPictographic
+        };
+
+
+        /**
+         * Returns the grapheme cluster break property of a code point. ASCII is handled directly; everything else is
+         * looked up by binary search in a table of ranges derived from the Unicode character database. Code points
+         * missing from the table are "other".
+         */
+        GraphemeBreakProperty graphemeBreakProperty( char32_t codePoint )
+        {
+            using enum GraphemeBreakProperty;
+
+            if(codePoint < 0x80)
+            {
+                if(codePoint == '\r')
+                {
+                    return cr;
+                }
+                if(codePoint == '\n')
+                {
+                    return lf;
+                }
+                return ((codePoint < 0x20) || (codePoint == 0x7F)) ? control : other;
+            }
+
+            struct Range
+            {
+                char32_t first;
+                char32_t last;
+                GraphemeBreakProperty property;
+            };
+            static constexpr Range table[] = {
+                {0x0080, 0x009F, control}, {0x00A9, 0x00A9, extendedPictographic}, {0x00AD, 0x00AD, control},
+                {0x00AE, 0x00AE, extendedPictographic}, {0x0300, 0x036F, extend}, {0x0483, 0x0489, extend},
+                {0x0591, 0x05BD, extend}, {0x05BF, 0x05BF, extend}, {0x05C1, 0x05C2, extend}, {0x05C4, 0x05C5, extend},
+                {0x05C7, 0x05C7, extend}, {0x0600, 0x0605, prepend}, {0x0610, 0x061A, extend}, {0x061C, 0x061C, control},
+                {0x064B, 0x065F, extend}, {0x0670, 0x0670, extend}, {0x06D6, 0x06DC, extend}, {0x06DD, 0x06DD, prepend},
+                {0x06DF, 0x06E4, extend}, {0x06E7, 0x06E8, extend}, {0x06EA, 0x06ED, extend}, {0x070F, 0x070F, prepend},
+                {0x0711, 0x0711, extend}, {0x0730, 0x074A, extend}, {0x07A6, 0x07B0, extend}, {0x07EB, 0x07F3, extend},
+                {0x07FD, 0x07FD, extend}, {0x0816, 0x0819, extend}, {0x081B, 0x0823, extend}, {0x0825, 0x0827, extend},
+                {0x0829, 0x082D, extend}, {0x0859, 0x085B, extend}, {0x0890, 0x0891, prepend}, {0x0898, 0x089F, extend},
+                {0x08CA, 0x08E1, extend}, {0x08E2, 0x08E2, prepend}, {0x08E3, 0x0902, extend}, {0x0903, 0x0903, spacingMark},
+                {0x093A, 0x093A, extend}, {0x093B, 0x093B, spacingMark}, {0x093C, 0x093C, extend}, {0x093E, 0x0940, spacingMark},
+                {0x0941, 0x0948, extend}, {0x0949, 0x094C, spacingMark}, {0x094D, 0x094D, extend}, {0x094E, 0x094F, spacingMark},
+                {0x0951, 0x0957, extend}, {0x0962, 0x0963, extend}, {0x0981, 0x0981, extend}, {0x0982, 0x0983, spacingMark},
+                {0x09BC, 0x09BC, extend}, {0x09BE, 0x09BE, extend}, {0x09BF, 0x09C0, spacingMark}, {0x09C1, 0x09C4, extend},
+                {0x09C7, 0x09C8, spacingMark}, {0x09CB, 0x09CC, spacingMark}, {0x09CD, 0x09CD, extend}, {0x09D7, 0x09D7, extend},
+                {0x09E2, 0x09E3, extend}, {0x09FE, 0x09FE, extend}, {0x0A01, 0x0A02, extend}, {0x0A03, 0x0A03, spacingMark},
+                {0x0A3C, 0x0A3C, extend}, {0x0A3E, 0x0A40, spacingMark}, {0x0A41, 0x0A42, extend}, {0x0A47, 0x0A48, extend},
+                {0x0A4B, 0x0A4D, extend}, {0x0A51, 0x0A51, extend}, {0x0A70, 0x0A71, extend}, {0x0A75, 0x0A75, extend},
+                {0x0A81, 0x0A82, extend}, {0x0A83, 0x0A83, spacingMark}, {0x0ABC, 0x0ABC, extend}, {0x0ABE, 0x0AC0, spacingMark},
+                {0x0AC1, 0x0AC5, extend}, {0x0AC7, 0x0AC8, extend}, {0x0AC9, 0x0AC9, spacingMark}, {0x0ACB, 0x0ACC, spacingMark},
+                {0x0ACD, 0x0ACD, extend}, {0x0AE2, 0x0AE3, extend}, {0x0AFA, 0x0AFF, extend}, {0x0B01, 0x0B01, extend},
+                {0x0B02, 0x0B03, spacingMark}, {0x0B3C, 0x0B3C, extend}, {0x0B3E, 0x0B3F, extend}, {0x0B40, 0x0B40, spacingMark},
+                {0x0B41, 0x0B44, extend}, {0x0B47, 0x0B48, spacingMark}, {0x0B4B, 0x0B4C, spacingMark}, {0x0B4D, 0x0B4D, extend},
+                {0x0B55, 0x0B57, extend}, {0x0B62, 0x0B63, extend}, {0x0B82, 0x0B82, extend}, {0x0BBE, 0x0BBE, extend},
+                {0x0BBF, 0x0BBF, spacingMark}, {0x0BC0, 0x0BC0, extend}, {0x0BC1, 0x0BC2, spacingMark},
+                {0x0BC6, 0x0BC8, spacingMark}, {0x0BCA, 0x0BCC, spacingMark}, {0x0BCD, 0x0BCD, extend}, {0x0BD7, 0x0BD7, extend},
+                {0x0C00, 0x0C00, extend}, {0x0C01, 0x0C03, spacingMark}, {0x0C04, 0x0C04, extend}, {0x0C3C, 0x0C3C, extend},
+                {0x0C3E, 0x0C40, extend}, {0x0C41, 0x0C44, spacingMark}, {0x0C46, 0x0C48, extend}, {0x0C4A, 0x0C4D, extend},
+                {0x0C55, 0x0C56, extend}, {0x0C62, 0x0C63, extend}, {0x0C81, 0x0C81, extend}, {0x0C82, 0x0C83, spacingMark},
+                {0x0CBC, 0x0CBC, extend}, {0x0CBE, 0x0CBE, spacingMark}, {0x0CBF, 0x0CBF, extend}, {0x0CC0, 0x0CC1, spacingMark},
+                {0x0CC2, 0x0CC2, extend}, {0x0CC3, 0x0CC4, spacingMark}, {0x0CC6, 0x0CC6, extend}, {0x0CC7, 0x0CC8, spacingMark},
+                {0x0CCA, 0x0CCB, spacingMark}, {0x0CCC, 0x0CCD, extend}, {0x0CD5, 0x0CD6, extend}, {0x0CE2, 0x0CE3, extend},
+                {0x0D00, 0x0D01, extend}, {0x0D02, 0x0D03, spacingMark}, {0x0D3B, 0x0D3C, extend}, {0x0D3E, 0x0D3E, extend},
+                {0x0D3F, 0x0D40, spacingMark}, {0x0D41, 0x0D44, extend}, {0x0D46, 0x0D48, spacingMark},
+                {0x0D4A, 0x0D4C, spacingMark}, {0x0D4D, 0x0D4D, extend}, {0x0D4E, 0x0D4E, prepend}, {0x0D57, 0x0D57, extend},
+                {0x0D62, 0x0D63, extend}, {0x0D81, 0x0D81, extend}, {0x0D82, 0x0D83, spacingMark}, {0x0DCA, 0x0DCA, extend},
+                {0x0DCF, 0x0DCF, extend}, {0x0DD0, 0x0DD1, spacingMark}, {0x0DD2, 0x0DD4, extend}, {0x0DD6, 0x0DD6, extend},
+                {0x0DD8, 0x0DDE, spacingMark}, {0x0DDF, 0x0DDF, extend}, {0x0DF2, 0x0DF3, spacingMark}, {0x0E31, 0x0E31, extend},
+                {0x0E33, 0x0E33, spacingMark}, {0x0E34, 0x0E3A, extend}, {0x0E47, 0x0E4E, extend}, {0x0EB1, 0x0EB1, extend},
+                {0x0EB3, 0x0EB3, spacingMark}, {0x0EB4, 0x0EBC, extend}, {0x0EC8, 0x0ECD, extend}, {0x0F18, 0x0F19, extend},
+                {0x0F35, 0x0F35, extend}, {0x0F37, 0x0F37, extend}, {0x0F39, 0x0F39, extend}, {0x0F3E, 0x0F3F, spacingMark},
+                {0x0F71, 0x0F7E, extend}, {0x0F7F, 0x0F7F, spacingMark}, {0x0F80, 0x0F84, extend}, {0x0F86, 0x0F87, extend},
+                {0x0F8D, 0x0F97, extend}, {0x0F99, 0x0FBC, extend}, {0x0FC6, 0x0FC6, extend}, {0x102D, 0x1030, extend},
+                {0x1031, 0x1031, spacingMark}, {0x1032, 0x1037, extend}, {0x1039, 0x103A, extend}, {0x103B, 0x103C, spacingMark},
+                {0x103D, 0x103E, extend}, {0x1056, 0x1057, spacingMark}, {0x1058, 0x1059, extend}, {0x105E, 0x1060, extend},
+                {0x1071, 0x1074, extend}, {0x1082, 0x1082, extend}, {0x1084, 0x1084, spacingMark}, {0x1085, 0x1086, extend},
+                {0x108D, 0x108D, extend}, {0x109D, 0x109D, extend}, {0x1100, 0x115F, l}, {0x1160, 0x11A7, v}, {0x11A8, 0x11FF, t},
+                {0x135D, 0x135F, extend}, {0x1712, 0x1714, extend}, {0x1715, 0x1715, spacingMark}, {0x1732, 0x1733, extend},
+                {0x1734, 0x1734, spacingMark}, {0x1752, 0x1753, extend}, {0x1772, 0x1773, extend}, {0x17B4, 0x17B5, extend},
+                {0x17B6, 0x17B6, spacingMark}, {0x17B7, 0x17BD, extend}, {0x17BE, 0x17C5, spacingMark}, {0x17C6, 0x17C6, extend},
+                {0x17C7, 0x17C8, spacingMark}, {0x17C9, 0x17D3, extend}, {0x17DD, 0x17DD, extend}, {0x180B, 0x180D, extend},
+                {0x180E, 0x180E, control}, {0x180F, 0x180F, extend}, {0x1885, 0x1886, extend}, {0x18A9, 0x18A9, extend},
+                {0x1920, 0x1922, extend}, {0x1923, 0x1926, spacingMark}, {0x1927, 0x1928, extend}, {0x1929, 0x192B, spacingMark},
+                {0x1930, 0x1931, spacingMark}, {0x1932, 0x1932, extend}, {0x1933, 0x1938, spacingMark}, {0x1939, 0x193B, extend},
+                {0x1A17, 0x1A18, extend}, {0x1A19, 0x1A1A, spacingMark}, {0x1A1B, 0x1A1B, extend}, {0x1A55, 0x1A55, spacingMark},
+                {0x1A56, 0x1A56, extend}, {0x1A57, 0x1A57, spacingMark}, {0x1A58, 0x1A5E, extend}, {0x1A60, 0x1A60, extend},
+                {0x1A62, 0x1A62, extend}, {0x1A65, 0x1A6C, extend}, {0x1A6D, 0x1A72, spacingMark}, {0x1A73, 0x1A7C, extend},
+                {0x1A7F, 0x1A7F, extend}, {0x1AB0, 0x1ACE, extend}, {0x1B00, 0x1B03, extend}, {0x1B04, 0x1B04, spacingMark},
+                {0x1B34, 0x1B3A, extend}, {0x1B3B, 0x1B3B, spacingMark}, {0x1B3C, 0x1B3C, extend}, {0x1B3D, 0x1B41, spacingMark},
+                {0x1B42, 0x1B42, extend}, {0x1B43, 0x1B44, spacingMark}, {0x1B6B, 0x1B73, extend}, {0x1B80, 0x1B81, extend},
+                {0x1B82, 0x1B82, spacingMark}, {0x1BA1, 0x1BA1, spacingMark}, {0x1BA2, 0x1BA5, extend},
+                {0x1BA6, 0x1BA7, spacingMark}, {0x1BA8, 0x1BA9, extend}, {0x1BAA, 0x1BAA, spacingMark}, {0x1BAB, 0x1BAD, extend},
+                {0x1BE6, 0x1BE6, extend}, {0x1BE7, 0x1BE7, spacingMark}, {0x1BE8, 0x1BE9, extend}, {0x1BEA, 0x1BEC, spacingMark},
+                {0x1BED, 0x1BED, extend}, {0x1BEE, 0x1BEE, spacingMark}, {0x1BEF, 0x1BF1, extend}, {0x1BF2, 0x1BF3, spacingMark},
+                {0x1C24, 0x1C2B, spacingMark}, {0x1C2C, 0x1C33, extend}, {0x1C34, 0x1C35, spacingMark}, {0x1C36, 0x1C37, extend},
+                {0x1CD0, 0x1CD2, extend}, {0x1CD4, 0x1CE0, extend}, {0x1CE1, 0x1CE1, spacingMark}, {0x1CE2, 0x1CE8, extend},
+                {0x1CED, 0x1CED, extend}, {0x1CF4, 0x1CF4, extend}, {0x1CF7, 0x1CF7, spacingMark}, {0x1CF8, 0x1CF9, extend},
+                {0x1DC0, 0x1DFF, extend}, {0x200B, 0x200B, control}, {0x200C, 0x200C, extend}, {0x200D, 0x200D, zwj},
+                {0x200E, 0x200F, control}, {0x2028, 0x202E, control}, {0x203C, 0x203C, extendedPictographic},
+                {0x2049, 0x2049, extendedPictographic}, {0x2060, 0x2064, control}, {0x2066, 0x206F, control},
+                {0x20D0, 0x20F0, extend}, {0x2122, 0x2122, extendedPictographic}, {0x2139, 0x2139, extendedPictographic},
+                {0x2194, 0x2199, extendedPictographic}, {0x21A9, 0x21AA, extendedPictographic},
+                {0x231A, 0x231B, extendedPictographic}, {0x2328, 0x2328, extendedPictographic},
+                {0x2388, 0x2388, extendedPictographic}, {0x23CF, 0x23CF, extendedPictographic},
+                {0x23E9, 0x23F3, extendedPictographic}, {0x23F8, 0x23FA, extendedPictographic},
+                {0x24C2, 0x24C2, extendedPictographic}, {0x25AA, 0x25AB, extendedPictographic},
+                {0x25B6, 0x25B6, extendedPictographic}, {0x25C0, 0x25C0, extendedPictographic},
+                {0x25FB, 0x25FE, extendedPictographic}, {0x2600, 0x2605, extendedPictographic},
+                {0x2607, 0x2612, extendedPictographic}, {0x2614, 0x2685, extendedPictographic},
+                {0x2690, 0x2705, extendedPictographic}, {0x2708, 0x2712, extendedPictographic},
+                {0x2714, 0x2714, extendedPictographic}, {0x2716, 0x2716, extendedPictographic},
+                {0x271D, 0x271D, extendedPictographic}, {0x2721, 0x2721, extendedPictographic},
+                {0x2728, 0x2728, extendedPictographic}, {0x2733, 0x2734, extendedPictographic},
+                {0x2744, 0x2744, extendedPictographic}, {0x2747, 0x2747, extendedPictographic},
+                {0x274C, 0x274C, extendedPictographic}, {0x274E, 0x274E, extendedPictographic},
+                {0x2753, 0x2755, extendedPictographic}, {0x2757, 0x2757, extendedPictographic},
+                {0x2763, 0x2767, extendedPictographic}, {0x2795, 0x2797, extendedPictographic},
+                {0x27A1, 0x27A1, extendedPictographic}, {0x27B0, 0x27B0, extendedPictographic},
+                {0x27BF, 0x27BF, extendedPictographic}, {0x2934, 0x2935, extendedPictographic},
+                {0x2B05, 0x2B07, extendedPictographic}, {0x2B1B, 0x2B1C, extendedPictographic},
+                {0x2B50, 0x2B50, extendedPictographic}, {0x2B55, 0x2B55, extendedPictographic}, {0x2CEF, 0x2CF1, extend},
+                {0x2D7F, 0x2D7F, extend}, {0x2DE0, 0x2DFF, extend}, {0x302A, 0x302F, extend},
+                {0x3030, 0x3030, extendedPictographic}, {0x303D, 0x303D, extendedPictographic}, {0x3099, 0x309A, extend},
+                {0x3297, 0x3297, extendedPictographic}, {0x3299, 0x3299, extendedPictographic}, {0xA66F, 0xA672, extend},
+                {0xA674, 0xA67D, extend}, {0xA69E, 0xA69F, extend}, {0xA6F0, 0xA6F1, extend}, {0xA802, 0xA802, extend},
+                {0xA806, 0xA806, extend}, {0xA80B, 0xA80B, extend}, {0xA823, 0xA824, spacingMark}, {0xA825, 0xA826, extend},
+                {0xA827, 0xA827, spacingMark}, {0xA82C, 0xA82C, extend}, {0xA880, 0xA881, spacingMark},
+                {0xA8B4, 0xA8C3, spacingMark}, {0xA8C4, 0xA8C5, extend}, {0xA8E0, 0xA8F1, extend}, {0xA8FF, 0xA8FF, extend},
+                {0xA926, 0xA92D, extend}, {0xA947, 0xA951, extend}, {0xA952, 0xA953, spacingMark}, {0xA960, 0xA97C, l},
+                {0xA980, 0xA982, extend}, {0xA983, 0xA983, spacingMark}, {0xA9B3, 0xA9B3, extend}, {0xA9B4, 0xA9B5, spacingMark},
+                {0xA9B6, 0xA9B9, extend}, {0xA9BA, 0xA9BB, spacingMark}, {0xA9BC, 0xA9BD, extend}, {0xA9BE, 0xA9C0, spacingMark},
+                {0xA9E5, 0xA9E5, extend}, {0xAA29, 0xAA2E, extend}, {0xAA2F, 0xAA30, spacingMark}, {0xAA31, 0xAA32, extend},
+                {0xAA33, 0xAA34, spacingMark}, {0xAA35, 0xAA36, extend}, {0xAA43, 0xAA43, extend}, {0xAA4C, 0xAA4C, extend},
+                {0xAA4D, 0xAA4D, spacingMark}, {0xAA7C, 0xAA7C, extend}, {0xAAB0, 0xAAB0, extend}, {0xAAB2, 0xAAB4, extend},
+                {0xAAB7, 0xAAB8, extend}, {0xAABE, 0xAABF, extend}, {0xAAC1, 0xAAC1, extend}, {0xAAEB, 0xAAEB, spacingMark},
+                {0xAAEC, 0xAAED, extend}, {0xAAEE, 0xAAEF, spacingMark}, {0xAAF5, 0xAAF5, spacingMark}, {0xAAF6, 0xAAF6, extend},
+                {0xABE3, 0xABE4, spacingMark}, {0xABE5, 0xABE5, extend}, {0xABE6, 0xABE7, spacingMark}, {0xABE8, 0xABE8, extend},
+                {0xABE9, 0xABEA, spacingMark}, {0xABEC, 0xABEC, spacingMark}, {0xABED, 0xABED, extend}, {0xAC00, 0xD7A3, lvOrLvt},
+                {0xD7B0, 0xD7C6, v}, {0xD7CB, 0xD7FB, t}, {0xFB1E, 0xFB1E, extend}, {0xFE00, 0xFE0F, extend},
+                {0xFE20, 0xFE2F, extend}, {0xFEFF, 0xFEFF, control}, {0xFF9E, 0xFF9F, extend}, {0xFFF9, 0xFFFB, control},
+                {0x101FD, 0x101FD, extend}, {0x102E0, 0x102E0, extend}, {0x10376, 0x1037A, extend}, {0x10A01, 0x10A03, extend},
+                {0x10A05, 0x10A06, extend}, {0x10A0C, 0x10A0F, extend}, {0x10A38, 0x10A3A, extend}, {0x10A3F, 0x10A3F, extend},
+                {0x10AE5, 0x10AE6, extend}, {0x10D24, 0x10D27, extend}, {0x10EAB, 0x10EAC, extend}, {0x10F46, 0x10F50, extend},
+                {0x10F82, 0x10F85, extend}, {0x11000, 0x11000, spacingMark}, {0x11001, 0x11001, extend},
+                {0x11002, 0x11002, spacingMark}, {0x11038, 0x11046, extend}, {0x11070, 0x11070, extend},
+                {0x11073, 0x11074, extend}, {0x1107F, 0x11081, extend}, {0x11082, 0x11082, spacingMark},
+                {0x110B0, 0x110B2, spacingMark}, {0x110B3, 0x110B6, extend}, {0x110B7, 0x110B8, spacingMark},
+                {0x110B9, 0x110BA, extend}, {0x110BD, 0x110BD, prepend}, {0x110C2, 0x110C2, extend}, {0x110CD, 0x110CD, prepend},
+                {0x11100, 0x11102, extend}, {0x11127, 0x1112B, extend}, {0x1112C, 0x1112C, spacingMark},
+                {0x1112D, 0x11134, extend}, {0x11145, 0x11146, spacingMark}, {0x11173, 0x11173, extend},
+                {0x11180, 0x11181, extend}, {0x11182, 0x11182, spacingMark}, {0x111B3, 0x111B5, spacingMark},
+                {0x111B6, 0x111BE, extend}, {0x111BF, 0x111C0, spacingMark}, {0x111C2, 0x111C3, prepend},
+                {0x111C9, 0x111CC, extend}, {0x111CE, 0x111CE, spacingMark}, {0x111CF, 0x111CF, extend},
+                {0x1122C, 0x1122E, spacingMark}, {0x1122F, 0x11231, extend}, {0x11232, 0x11233, spacingMark},
+                {0x11234, 0x11234, extend}, {0x11235, 0x11235, spacingMark}, {0x11236, 0x11237, extend},
+                {0x1123E, 0x1123E, extend}, {0x112DF, 0x112DF, extend}, {0x112E0, 0x112E2, spacingMark},
+                {0x112E3, 0x112EA, extend}, {0x11300, 0x11301, extend}, {0x11302, 0x11303, spacingMark},
+                {0x1133B, 0x1133C, extend}, {0x1133E, 0x1133E, extend}, {0x1133F, 0x1133F, spacingMark},
+                {0x11340, 0x11340, extend}, {0x11341, 0x11344, spacingMark}, {0x11347, 0x11348, spacingMark},
+                {0x1134B, 0x1134D, spacingMark}, {0x11357, 0x11357, extend}, {0x11362, 0x11363, spacingMark},
+                {0x11366, 0x1136C, extend}, {0x11370, 0x11374, extend}, {0x11435, 0x11437, spacingMark},
+                {0x11438, 0x1143F, extend}, {0x11440, 0x11441, spacingMark}, {0x11442, 0x11444, extend},
+                {0x11445, 0x11445, spacingMark}, {0x11446, 0x11446, extend}, {0x1145E, 0x1145E, extend},
+                {0x114B0, 0x114B0, extend}, {0x114B1, 0x114B2, spacingMark}, {0x114B3, 0x114B8, extend},
+                {0x114B9, 0x114B9, spacingMark}, {0x114BA, 0x114BA, extend}, {0x114BB, 0x114BC, spacingMark},
+                {0x114BD, 0x114BD, extend}, {0x114BE, 0x114BE, spacingMark}, {0x114BF, 0x114C0, extend},
+                {0x114C1, 0x114C1, spacingMark}, {0x114C2, 0x114C3, extend}, {0x115AF, 0x115AF, extend},
+                {0x115B0, 0x115B1, spacingMark}, {0x115B2, 0x115B5, extend}, {0x115B8, 0x115BB, spacingMark},
+                {0x115BC, 0x115BD, extend}, {0x115BE, 0x115BE, spacingMark}, {0x115BF, 0x115C0, extend},
+                {0x115DC, 0x115DD, extend}, {0x11630, 0x11632, spacingMark}, {0x11633, 0x1163A, extend},
+                {0x1163B, 0x1163C, spacingMark}, {0x1163D, 0x1163D, extend}, {0x1163E, 0x1163E, spacingMark},
+                {0x1163F, 0x11640, extend}, {0x116AB, 0x116AB, extend}, {0x116AC, 0x116AC, spacingMark},
+                {0x116AD, 0x116AD, extend}, {0x116AE, 0x116AF, spacingMark}, {0x116B0, 0x116B5, extend},
+                {0x116B6, 0x116B6, spacingMark}, {0x116B7, 0x116B7, extend}, {0x1171D, 0x1171F, extend},
+                {0x11722, 0x11725, extend}, {0x11726, 0x11726, spacingMark}, {0x11727, 0x1172B, extend},
+                {0x1182C, 0x1182E, spacingMark}, {0x1182F, 0x11837, extend}, {0x11838, 0x11838, spacingMark},
+                {0x11839, 0x1183A, extend}, {0x11930, 0x11930, extend}, {0x11931, 0x11935, spacingMark},
+                {0x11937, 0x11938, spacingMark}, {0x1193B, 0x1193C, extend}, {0x1193D, 0x1193D, spacingMark},
+                {0x1193E, 0x1193E, extend}, {0x1193F, 0x1193F, prepend}, {0x11940, 0x11940, spacingMark},
+                {0x11941, 0x11941, prepend}, {0x11942, 0x11942, spacingMark}, {0x11943, 0x11943, extend},
+                {0x119D1, 0x119D3, spacingMark}, {0x119D4, 0x119D7, extend}, {0x119DA, 0x119DB, extend},
+                {0x119DC, 0x119DF, spacingMark}, {0x119E0, 0x119E0, extend}, {0x119E4, 0x119E4, spacingMark},
+                {0x11A01, 0x11A0A, extend}, {0x11A33, 0x11A38, extend}, {0x11A39, 0x11A39, spacingMark},
+                {0x11A3A, 0x11A3A, prepend}, {0x11A3B, 0x11A3E, extend}, {0x11A47, 0x11A47, extend}, {0x11A51, 0x11A56, extend},
+                {0x11A57, 0x11A58, spacingMark}, {0x11A59, 0x11A5B, extend}, {0x11A84, 0x11A89, prepend},
+                {0x11A8A, 0x11A96, extend}, {0x11A97, 0x11A97, spacingMark}, {0x11A98, 0x11A99, extend},
+                {0x11C2F, 0x11C2F, spacingMark}, {0x11C30, 0x11C36, extend}, {0x11C38, 0x11C3D, extend},
+                {0x11C3E, 0x11C3E, spacingMark}, {0x11C3F, 0x11C3F, extend}, {0x11C92, 0x11CA7, extend},
+                {0x11CA9, 0x11CA9, spacingMark}, {0x11CAA, 0x11CB0, extend}, {0x11CB1, 0x11CB1, spacingMark},
+                {0x11CB2, 0x11CB3, extend}, {0x11CB4, 0x11CB4, spacingMark}, {0x11CB5, 0x11CB6, extend},
+                {0x11D31, 0x11D36, extend}, {0x11D3A, 0x11D3A, extend}, {0x11D3C, 0x11D3D, extend}, {0x11D3F, 0x11D45, extend},
+                {0x11D46, 0x11D46, prepend}, {0x11D47, 0x11D47, extend}, {0x11D8A, 0x11D8E, spacingMark},
+                {0x11D90, 0x11D91, extend}, {0x11D93, 0x11D94, spacingMark}, {0x11D95, 0x11D95, extend},
+                {0x11D96, 0x11D96, spacingMark}, {0x11D97, 0x11D97, extend}, {0x11EF3, 0x11EF4, extend},
+                {0x11EF5, 0x11EF6, spacingMark}, {0x13430, 0x13438, control}, {0x16AF0, 0x16AF4, extend},
+                {0x16B30, 0x16B36, extend}, {0x16F4F, 0x16F4F, extend}, {0x16F51, 0x16F87, spacingMark},
+                {0x16F8F, 0x16F92, extend}, {0x16FE4, 0x16FE4, extend}, {0x16FF0, 0x16FF1, spacingMark},
+                {0x1BC9D, 0x1BC9E, extend}, {0x1BCA0, 0x1BCA3, control}, {0x1CF00, 0x1CF2D, extend}, {0x1CF30, 0x1CF46, extend},
+                {0x1D165, 0x1D165, extend}, {0x1D166, 0x1D166, spacingMark}, {0x1D167, 0x1D169, extend},
+                {0x1D16D, 0x1D16D, spacingMark}, {0x1D16E, 0x1D172, extend}, {0x1D173, 0x1D17A, control},
+                {0x1D17B, 0x1D182, extend}, {0x1D185, 0x1D18B, extend}, {0x1D1AA, 0x1D1AD, extend}, {0x1D242, 0x1D244, extend},
+                {0x1DA00, 0x1DA36, extend}, {0x1DA3B, 0x1DA6C, extend}, {0x1DA75, 0x1DA75, extend}, {0x1DA84, 0x1DA84, extend},
+                {0x1DA9B, 0x1DA9F, extend}, {0x1DAA1, 0x1DAAF, extend}, {0x1E000, 0x1E006, extend}, {0x1E008, 0x1E018, extend},
+                {0x1E01B, 0x1E021, extend}, {0x1E023, 0x1E024, extend}, {0x1E026, 0x1E02A, extend}, {0x1E130, 0x1E136, extend},
+                {0x1E2AE, 0x1E2AE, extend}, {0x1E2EC, 0x1E2EF, extend}, {0x1E8D0, 0x1E8D6, extend}, {0x1E944, 0x1E94A, extend},
+                {0x1F000, 0x1F0FF, extendedPictographic}, {0x1F10D, 0x1F10F, extendedPictographic},
+                {0x1F12F, 0x1F12F, extendedPictographic}, {0x1F16C, 0x1F171, extendedPictographic},
+                {0x1F17E, 0x1F17F, extendedPictographic}, {0x1F18E, 0x1F18E, extendedPictographic},
+                {0x1F191, 0x1F19A, extendedPictographic}, {0x1F1AD, 0x1F1E5, extendedPictographic},
+                {0x1F1E6, 0x1F1FF, regionalIndicator}, {0x1F201, 0x1F20F, extendedPictographic},
+                {0x1F21A, 0x1F21A, extendedPictographic}, {0x1F22F, 0x1F22F, extendedPictographic},
+                {0x1F232, 0x1F23A, extendedPictographic}, {0x1F23C, 0x1F23F, extendedPictographic},
+                {0x1F249, 0x1F3FA, extendedPictographic}, {0x1F3FB, 0x1F3FF, extend}, {0x1F400, 0x1F53D, extendedPictographic},
+                {0x1F546, 0x1F64F, extendedPictographic}, {0x1F680, 0x1F6FF, extendedPictographic},
+                {0x1F774, 0x1F77F, extendedPictographic}, {0x1F7D5, 0x1F7FF, extendedPictographic},
+                {0x1F80C, 0x1F80F, extendedPictographic}, {0x1F848, 0x1F84F, extendedPictographic},
+                {0x1F85A, 0x1F85F, extendedPictographic}, {0x1F888, 0x1F88F, extendedPictographic},
+                {0x1F8AE, 0x1F8FF, extendedPictographic}, {0x1F90C, 0x1F93A, extendedPictographic},
+                {0x1F93C, 0x1F945, extendedPictographic}, {0x1F947, 0x1FAFF, extendedPictographic},
+                {0x1FC00, 0x1FFFD, extendedPictographic}, {0xE0001, 0xE0001, control}, {0xE0020, 0xE007F, extend},
+                {0xE0100, 0xE01EF, extend}
+            };
+
+            const Range * range = std::upper_bound( std::begin(table), std::end(table), codePoint,
+                                                    [](char32_t c, const Range & r) { return c < r.first; } );
+            if((range == std::begin(table)) || ((range - 1)->last < codePoint))
+            {
+                return other;
+            }
+            const GraphemeBreakProperty property = (range - 1)->property;
+            if(property == lvOrLvt)
+            {
+                return ((codePoint - 0xAC00) % 28 == 0) ? lv : lvt;
+            }
+            return property;
+        }
+
+
+        /**
+         * Returns the end of the grapheme cluster starting at p, following the boundary rules GB3 to GB13 of Unicode
+         * Standard Annex #29. The input must be valid UTF-8 and p must be lower than end.
+         */
+        const unsigned char * nextGraphemeBoundary( const unsigned char * p,
+                                                    const unsigned char * end   )
+        {
+            using enum GraphemeBreakProperty;
+
+            GraphemeBreakProperty previous = graphemeBreakProperty(decodeValidUtf8(p));
+            //True after Extended_Pictographic Extend*, and after Extended_Pictographic Extend* ZWJ
+            bool inPictographicSequence = (previous == extendedPictographic);
+            bool afterPictographicZwj = false;
+            std::size_t regionalIndicators = (previous == regionalIndicator);
+
+            while(p < end)
+            {
+                const unsigned char * next = p;
+                const GraphemeBreakProperty current = graphemeBreakProperty(decodeValidUtf8(next));
+
+                bool joined;
+                if((previous == cr) && (current == lf))
+                {
+                    joined = true;
+                }
+                else if((previous == control) || (previous == cr) || (previous == lf)
+                        || (current == control) || (current == cr) || (current == lf))
+                {
+                    joined = false;
+                }
+                else if((previous == l) && ((current == l) || (current == v) || (current == lv) || (current == lvt)))
+                {
+                    joined = true;
+                }
+                else if(((previous == lv) || (previous == v)) && ((current == v) || (current == t)))
+                {
+                    joined = true;
+                }
+                else if(((previous == lvt) || (previous == t)) && (current == t))
+                {
+                    joined = true;
+                }
+                else if((current == extend) || (current == zwj) || (current == spacingMark) || (previous == prepend))
+                {
+                    joined = true;
+                }
+                else if((previous == zwj) && (current == extendedPictographic))
+                {
+                    joined = afterPictographicZwj;
+                }
+                else if((previous == regionalIndicator) && (current == regionalIndicator))
+                {
+                    joined = (regionalIndicators % 2 == 1);
+                }
+                else
+                {
+                    joined = false;
+                }
+
+                if(!joined)
+                {
+                    break;
+                }
+
+                afterPictographicZwj = (current == zwj) && inPictographicSequence;
+                inPictographicSequence = (current == extendedPictographic) || ((current == extend) && inPictographicSequence);
+                regionalIndicators = (current == regionalIndicator) ? regionalIndicators + 1 : 0;
+                previous = current;
+                p = next;
+            }
+            return p;
+        }
+
+
+        /**
+         * Returns the offsets of the grapheme cluster boundaries of a valid UTF-8 string, including 0 and str.size().
+         */
+        std::vector<std::size_t> graphemeBoundaries( std::string_view str )
+        {
+            std::vector<std::size_t> boundaries = {0};
+            const unsigned char * const begin = reinterpret_cast<const unsigned char *>(str.data());
+            const unsigned char * const end = begin + str.size();
+            for(const unsigned char * p = begin; p < end; )
+            {
+                p = nextGraphemeBoundary(p, end);
+                boundaries.push_back(p - begin);
+            }
+            return boundaries;
+        }
+
+
+        /**
+         * Throws std::invalid_argument naming the caller if str is not valid UTF-8.
+         */
+        void requireValidUtf8(  std::string_view str,
+                                const char * functionName   )
+        {
+            if(!isValidUtf8(str))
+            {
+                throw std::invalid_argument(std::string(functionName) + "(): the input is not valid UTF-8");
+            }
+        }
+    }
+
+
+    /**
+     * Counts the grapheme clusters (user-perceived characters) of a UTF-8 string, as defined by Unicode Standard Annex
+     * #29. For example "é" (e followed by a combining acute accent) counts as one.
+     *
+     * Throws std::invalid_argument if str is not valid UTF-8.
+     *
+     * @param str - The UTF-8 string whose grapheme clusters we want to count.
+     *
+     * @retval std::size_t - The number of grapheme clusters in str.
+     */
+    std::size_t countGraphemes( std::string_view str )
+    {
+        if(isAscii(str))
+        {
+            //Every ASCII character is a cluster of its own, except for CR LF
+            std::size_t crlf = 0;
+            for(std::size_t pos = str.find("\r\n"); pos != std::string_view::npos; pos = str.find("\r\n", pos + 2))
+            {
+                ++crlf;
+            }
+            return str.size() - crlf;
+        }
+        detail::requireValidUtf8(str, "countGraphemes");
+
+        std::size_t count = 0;
+        const unsigned char * p = reinterpret_cast<const unsigned char *>(str.data());
+        const unsigned char * const end = p + str.size();
+        while(p < end)
+        {
+            p = detail::nextGraphemeBoundary(p, end);
+            ++count;
+        }
+        return count;
+    }
+
+
+    /**
+     * Reverses the order of the code points of a UTF-8 string in place. Each multibyte sequence is first reversed on its
+     * own, then the whole string is reversed, which restores the bytes of each code point in their original order.
+     *
+     * Throws std::invalid_argument if str is not valid UTF-8; str is left untouched in that case.
+     *
+     * @param str - The UTF-8 string we would like to reverse.
+     */
+    void reverseCodePointsInPlace( std::string & str )
+    {
+        if(!isAscii(str))
+        {
+            detail::requireValidUtf8(str, "reverseCodePointsInPlace");
+            std::size_t i = 0;
+            while(i < str.size())
+            {
+                const unsigned char lead = static_cast<unsigned char>(str[i]);
+                const std::size_t length = (lead < 0x80) ? 1 : (lead < 0xE0) ? 2 : (lead < 0xF0) ? 3 : 4;
+                std::reverse(str.begin() + i, str.begin() + i + length);
+                i += length;
+            }
+        }
+        std::reverse(str.begin(), str.end());
+    }
+
+
+    /**
+     * Returns a UTF-8 string with the order of its code points reversed, keeping the result valid UTF-8.
+     *
+     * Throws std::invalid_argument if str is not valid UTF-8.
+     *
+     * @param str - The UTF-8 string we would like to reverse.
+     *
+     * @retval std::string - The reversed string.
+     */
+    std::string reverseCodePoints( std::string_view str )
+    {
+        std::string result(str);
+        reverseCodePointsInPlace(result);
+        return result;
+    }
+
+
+    /**
+     * Reverses the order of the grapheme clusters of a UTF-8 string in place, so that combining marks, emoji sequences
+     * and flags stay attached to their base character. As for reverseCodePointsInPlace(), each cluster is reversed on its
+     * own before the whole string is reversed.
+     *
+     * Throws std::invalid_argument if str is not valid UTF-8; str is left untouched in that case.
+     *
+     * @param str - The UTF-8 string we would like to reverse.
+     */
+    void reverseGraphemesInPlace( std::string & str )
+    {
+        if(isAscii(str))
+        {
+            //Single bytes are clusters on their own, except CR LF which must stay in this order
+            std::reverse(str.begin(), str.end());
+            for(std::size_t pos = str.find("\n\r"); pos != std::string::npos; pos = str.find("\n\r", pos + 2))
+            {
+                str[pos] = '\r';
+                str[pos + 1] = '\n';
+            }
+            return;
+        }
+        detail::requireValidUtf8(str, "reverseGraphemesInPlace");
+
+        unsigned char * const begin = reinterpret_cast<unsigned char *>(str.data());
+        unsigned char * const end = begin + str.size();
+        for(unsigned char * p = begin; p < end; )
+        {
+            unsigned char * clusterEnd = const_cast<unsigned char *>(detail::nextGraphemeBoundary(p, end));
+            std::reverse(p, clusterEnd);
+            p = clusterEnd;
+        }
+        std::reverse(begin, end);
+    }
+
+
+    /**
+     * Returns a UTF-8 string with the order of its grapheme clusters reversed. See reverseGraphemesInPlace().
+     *
+     * Throws std::invalid_argument if str is not valid UTF-8.
+     *
+     * @param str - The UTF-8 string we would like to reverse.
+     *
+     * @retval std::string - The reversed string.
+     */
+    std::string reverseGraphemes( std::string_view str )
+    {
+        std::string result(str);
+        reverseGraphemesInPlace(result);
+        return result;
+    }
+
+
+    /**
+     * Checks whether a UTF-8 string reads the same in both directions when compared code point by code point, so that
+     * "été" written with precomposed accents is a palindrome. No memory is allocated.
+     *
+     * Throws std::invalid_argument if str is not valid UTF-8.
+     *
+     * @param str - The UTF-8 string we would like to check.
+     *
+     * @retval bool - true if str is a palindrome, false otherwise.
+     */
+    bool isCodePointPalindrome( std::string_view str )
+    {
+        if(isAscii(str))
+        {
+            return isPalindrome(str, PalindromePolicy::strict);
+        }
+        detail::requireValidUtf8(str, "isCodePointPalindrome");
+
+        const unsigned char * front = reinterpret_cast<const unsigned char *>(str.data());
+        const unsigned char * back = front + str.size();
+        while(front < back)
+        {
+            //Step back to the lead byte of the last code point
+            const unsigned char * lead = back - 1;
+            while((*lead & 0xC0) == 0x80)
+            {
+                --lead;
+            }
+            if(lead <= front)
+            {
+                //Middle code point
+                return true;
+            }
+            const unsigned char * p = lead;
+            if(detail::decodeValidUtf8(front) != detail::decodeValidUtf8(p))
+            {
+                return false;
+            }
+            back = lead;
+        }
+        return true;
+    }
+
+
+    /**
+     * Checks whether a UTF-8 string reads the same in both directions when compared grapheme cluster by grapheme
+     * cluster, so that "été" is a palindrome even when written with combining accents.
+     *
+     * Throws std::invalid_argument if str is not valid UTF-8.
+     *
+     * @param str - The UTF-8 string we would like to check.
+     *
+     * @retval bool - true if str is a palindrome, false otherwise.
+     */
+    bool isGraphemePalindrome( std::string_view str )
+    {
+        if(isAscii(str) && (str.find('\r') == std::string_view::npos))
+        {
+            return isPalindrome(str, PalindromePolicy::strict);
+        }
+        detail::requireValidUtf8(str, "isGraphemePalindrome");
+
+        const std::vector<std::size_t> boundaries = detail::graphemeBoundaries(str);
+        std::size_t first = 0;
+        std::size_t last = boundaries.size() - 2;
+        while(first < last)
+        {
+            const std::string_view frontCluster = str.substr(boundaries[first], boundaries[first + 1] - boundaries[first]);
+            const std::string_view backCluster = str.substr(boundaries[last], boundaries[last + 1] - boundaries[last]);
+            if(frontCluster != backCluster)
+            {
+                return false;
+            }
+            ++first;
+            --last;
+        }
+        return true;
+    }
+
+
+    /**
+     * A read-only view of a whole file. On POSIX systems the file is memory-mapped, so opening even a very large file
+     * costs nothing until its pages are read; elsewhere the file is read into memory.
+     *
+     * Throws std::invalid_argument if the file cannot be opened.
+     */
+    class MappedFile
+    {
+    public:
+        explicit MappedFile( const std::string & filePath )
+        {
+#ifdef STEVENSSTRINGLIB_POSIX
+            const int descriptor = ::open(filePath.c_str(), O_RDONLY);
+            if(descriptor < 0)
+            {
+                throw std::invalid_argument("Error, could not find file: " + filePath);
+            }
+            struct stat status;
+            if(::fstat(descriptor, &status) != 0)
+            {
+                ::close(descriptor);
+                throw std::invalid_argument("Error, could not read file: " + filePath);
+            }
+            m_size = status.st_size;
+            if(m_size != 0)
+            {
+                void * address = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+                if(address == MAP_FAILED)
+                {
+                    ::close(descriptor);
+                    throw std::invalid_argument("Error, could not map file: " + filePath);
+                }
+                ::madvise(address, m_size, MADV_SEQUENTIAL);
+                m_data = static_cast<const char *>(address);
+            }
+            ::close(descriptor);
+#else
+            std::ifstream input_file(filePath, std::ios::binary);
+            if (!input_file.is_open())
+            {
+                throw std::invalid_argument("Error, could not find file: " + filePath);
+            }
+            m_buffer = std::string((std::istreambuf_iterator<char>(input_file)), std::istreambuf_iterator<char>());
+            m_data = m_buffer.data();
+            m_size = m_buffer.size();
+#endif
+        }
+
+        MappedFile( const MappedFile & ) = delete;
+        MappedFile & operator=( const MappedFile & ) = delete;
+
+        MappedFile( MappedFile && other ) noexcept
+        {
+            swap(other);
+        }
+
+        MappedFile & operator=( MappedFile && other ) noexcept
+        {
+            MappedFile moved(std::move(other));
+            swap(moved);
+            return *this;
+        }
+
+        ~MappedFile()
+        {
+#ifdef STEVENSSTRINGLIB_POSIX
+            if(m_data != nullptr)
+            {
+                ::munmap(const_cast<char *>(m_data), m_size);
+            }
+#endif
+        }
+
+        std::string_view view() const
+        {
+            return std::string_view(m_data, m_size);
+        }
+
+        std::size_t size() const
+        {
+            return m_size;
+        }
+
+    private:
+        MappedFile() = default;
+
+        void swap( MappedFile & other ) noexcept
+        {
+            std::swap(m_data, other.m_data);
+            std::swap(m_size, other.m_size);
+#ifndef STEVENSSTRINGLIB_POSIX
+            std::swap(m_buffer, other.m_buffer);
+            //Small strings keep their characters inline, so the pointers must follow the buffers
+            m_data = m_buffer.data();
+            other.m_data = other.m_buffer.data();
+#endif
+        }
+
+        const char * m_data = nullptr;
+        std::size_t m_size = 0;
+#ifndef STEVENSSTRINGLIB_POSIX
+        std::string m_buffer;
+#endif
+    };
+
+
+    /**
+     * Which ends of a fixed-width field are stripped of their whitespace padding.
+     */
+    enum class FieldTrim : std::uint8_t
+    {
+        none,
+        leading,
+        trailing,
+        both
+    };
+
+
+    /**
+     * Where a value shorter than its fixed-width field is placed when writing records.
+     */
+    enum class FieldAlign : std::uint8_t
+    {
+        left,
+        right
+    };
+
+
+    /**
+     * A column of a fixed-width record: the field occupies width bytes starting at offset in each record. trim is used
+     * when reading the field, align when writing it.
+     */
+    struct FixedWidthColumn
+    {
+        std::size_t offset;
+        std::size_t width;
+        FieldTrim trim = FieldTrim::both;
+        FieldAlign align = FieldAlign::left;
+    };
+
+
+    namespace detail
+    {
+        /**
+         * Removes the whitespace padding of a field according to a trim policy.
+         */
+        std::string_view trimField( std::string_view field,
+                                    FieldTrim trim  )
+        {
+            std::size_t begin = 0;
+            std::size_t end = field.size();
+            if((trim == FieldTrim::leading) || (trim == FieldTrim::both))
+            {
+                begin = skipLeadingWhitespace(field.data(), end);
+            }
+            if((trim == FieldTrim::trailing) || (trim == FieldTrim::both))
+            {
+                end = begin + skipTrailingWhitespace(field.data() + begin, end - begin);
+            }
+            return field.substr(begin, end - begin);
+        }
+
+
+        /**
+         * Checks that the columns fit in records of recordLength bytes and returns the number of bytes a record needs
+         * to hold all of them.
+         */
+        std::size_t fixedWidthRecordSpan(   std::size_t recordLength,
+                                            std::span<const FixedWidthColumn> columns   )
+        {
+            if(recordLength == 0)
+            {
+                throw std::invalid_argument("Fixed-width records cannot be empty");
+            }
+            std::size_t span = 0;
+            for(const FixedWidthColumn & column : columns)
+            {
+                if((column.offset > recordLength) || (column.width > recordLength - column.offset))
+                {
+                    throw std::invalid_argument("A fixed-width column goes past the end of the record");
+                }
+                span = std::max(span, column.offset + column.width);
+            }
+            return span;
+        }
+    }
+
+
+    /**
+     * Splits fixed-width records into trimmed fields without copying anything. data holds records of recordLength bytes
+     * each (including the line terminator, if any); for each record, callback(recordIndex, fields) is called with a
+     * span holding one view per column, pointing into data. The span is reused from one record to the next, so copy
+     * the views if they must outlive the call. A last, shorter record (e.g. without a final newline) is processed if it
+     * still holds every column.
+     *
+     * Combined with MappedFile, this parses a file of fixed-width records with a single allocation.
+     *
+     * Throws std::invalid_argument if recordLength is 0 or a column does not fit in a record.
+     *
+     * @param data - The records, back to back.
+     * @param recordLength - The size of a record in bytes.
+     * @param columns - The position, width and trim policy of each field.
+     * @param callback - Called as callback(std::size_t, std::span<const std::string_view>) for each record.
+     *
+     * @retval std::size_t - The number of records processed.
+     */
+    template<typename Callback>
+    std::size_t forEachFixedWidthRecord(    std::string_view data,
+                                            std::size_t recordLength,
+                                            std::span<const FixedWidthColumn> columns,
+                                            Callback && callback    )
+    {
+        const std::size_t recordSpan = detail::fixedWidthRecordSpan(recordLength, columns);
+        std::size_t recordCount = data.size() / recordLength;
+        if((data.size() % recordLength != 0) && (data.size() % recordLength >= recordSpan))
+        {
+            ++recordCount;
+        }
+
+        std::vector<std::string_view> fields(columns.size());
+        for(std::size_t record = 0; record < recordCount; ++record)
+        {
+            const char * const recordData = data.data() + record * recordLength;
+            for(std::size_t c = 0; c < columns.size(); ++c)
+            {
+                const std::string_view field(recordData + columns[c].offset, columns[c].width);
+                fields[c] = detail::trimField(field, columns[c].trim);
+            }
+            callback(record, std::span<const std::string_view>(fields));
+        }
+        return recordCount;
+    }
+
+
+    /**
+     * A validated description of fixed-width records: their length and the columns they hold. The layout is checked
+     * once when it is built, so reading and writing records afterwards does no further validation.
+     *
+     * Throws std::invalid_argument if recordLength is 0 or a column does not fit in a record.
+     */
+    class FixedWidthLayout
+    {
+    public:
+        FixedWidthLayout(   std::vector<FixedWidthColumn> columns,
+                            std::size_t recordLength    )
+            : m_columns(std::move(columns)),
+              m_recordLength(recordLength),
+              m_recordSpan(detail::fixedWidthRecordSpan(recordLength, m_columns))
+        {
+        }
+
+        std::size_t recordLength() const
+        {
+            return m_recordLength;
+        }
+
+        /**
+         * The number of bytes at the start of a record that are covered by the columns.
+         */
+        std::size_t recordSpan() const
+        {
+            return m_recordSpan;
+        }
+
+        std::span<const FixedWidthColumn> columns() const
+        {
+            return m_columns;
+        }
+
+        /**
+         * The number of records in data, counting a last, shorter record if it still holds every column.
+         */
+        std::size_t recordCount( std::string_view data ) const
+        {
+            const std::size_t remainder = data.size() % m_recordLength;
+            return data.size() / m_recordLength + (((remainder != 0) && (remainder >= m_recordSpan)) ? 1 : 0);
+        }
+
+        /**
+         * Returns the trimmed field of a column in a record, without bounds checking.
+         */
+        std::string_view field(     std::string_view data,
+                                    std::size_t record,
+                                    std::size_t column  ) const
+        {
+            const FixedWidthColumn & c = m_columns[column];
+            return detail::trimField(data.substr(record * m_recordLength + c.offset, c.width), c.trim);
+        }
+
+        /**
+         * Calls callback(recordIndex, fields) for each record in data, as forEachFixedWidthRecord() does.
+         *
+         * @retval std::size_t - The number of records processed.
+         */
+        template<typename Callback>
+        std::size_t forEachRecord(  std::string_view data,
+                                    Callback && callback    ) const
+        {
+            return forEachFixedWidthRecord(data, m_recordLength, m_columns, callback);
+        }
+
+        /**
+         * Like forEachRecord(), but the records are split into contiguous chunks processed by threadCount threads.
+         * Records keep their index in data, but the callback is called concurrently and in no particular order, so it
+         * must be safe to call from several threads. If the callback throws, the first exception is rethrown once
+         * every thread is done.
+         *
+         * @param data - The records, back to back.
+         * @param callback - Called as callback(std::size_t, std::span<const std::string_view>) for each record.
+         * @param threadCount - The number of threads to use, or 0 to use one per hardware thread.
+         *
+         * @retval std::size_t - The number of records processed.
+         */
+        template<typename Callback>
+        std::size_t forEachRecordParallel(  std::string_view data,
+                                            Callback && callback,
+                                            unsigned threadCount = 0    ) const
+        {
+            const std::size_t recordCount = this->recordCount(data);
+            if(threadCount == 0)
+            {
+                threadCount = std::max(1u, std::thread::hardware_concurrency());
+            }
+            threadCount = static_cast<unsigned>(std::min<std::size_t>(threadCount, recordCount));
+            if(threadCount <= 1)
+            {
+                return forEachRecord(data, callback);
+            }
+
+            std::vector<std::exception_ptr> errors(threadCount);
+            std::vector<std::thread> threads;
+            threads.reserve(threadCount);
+            for(unsigned t = 0; t < threadCount; ++t)
+            {
+                const std::size_t first = recordCount * t / threadCount;
+                const std::size_t last = recordCount * (t + 1) / threadCount;
+                //The last chunk runs to the end of data so that it keeps a shorter final record
+                const std::string_view chunk = (t + 1 == threadCount) ? data.substr(first * m_recordLength)
+                                                                      : data.substr(first * m_recordLength, (last - first) * m_recordLength);
+                threads.emplace_back([this, chunk, first, &callback, &error = errors[t]]()
+                {
+                    try
+                    {
+                        forEachRecord(chunk, [&](std::size_t record, std::span<const std::string_view> fields)
+                        {
+                            callback(first + record, fields);
+                        });
+                    }
+                    catch(...)
+                    {
+                        error = std::current_exception();
+                    }
+                });
+            }
+            for(std::thread & thread : threads)
+            {
+                thread.join();
+            }
+            for(const std::exception_ptr & error : errors)
+            {
+                if(error)
+                {
+                    std::rethrow_exception(error);
+                }
+            }
+            return recordCount;
+        }
+
+    private:
+        std::vector<FixedWidthColumn> m_columns;
+        std::size_t m_recordLength;
+        std::size_t m_recordSpan;
+    };
+
+
+    /**
+     * Writes fixed-width records into a single buffer, which grows by doubling if more records are written than were
+     * reserved. Each record is filled with the padding character, each field is copied into its column according to
+     * the column's alignment, and the terminator is written at the end of the record.
+     *
+     * Throws std::invalid_argument if the terminator overlaps the columns of the layout.
+     */
+    class FixedWidthWriter
+    {
+    public:
+        FixedWidthWriter(   FixedWidthLayout layout,
+                            std::size_t expectedRecords = 0,
+                            char padding = ' ',
+                            std::string_view terminator = "\n"  )
+            : m_layout(std::move(layout)),
+              m_padding(padding),
+              m_terminator(terminator)
+        {
+            if(m_terminator.size() > m_layout.recordLength() - m_layout.recordSpan())
+            {
+                throw std::invalid_argument("FixedWidthWriter(): the record terminator overlaps the columns");
+            }
+            m_buffer.resize(expectedRecords * m_layout.recordLength());
+        }
+
+        /**
+         * Appends a record holding one value per column.
+         *
+         * Throws std::invalid_argument if the number of values does not match the number of columns, or if a value is
+         * wider than its column.
+         */
+        void writeRecord( std::span<const std::string_view> fields )
+        {
+            const std::span<const FixedWidthColumn> columns = m_layout.columns();
+            if(fields.size() != columns.size())
+            {
+                throw std::invalid_argument("writeRecord(): expected " + std::to_string(columns.size()) + " fields, got " + std::to_string(fields.size()));
+            }
+            const std::size_t recordLength = m_layout.recordLength();
+            if(m_buffer.size() - m_used < recordLength)
+            {
+                m_buffer.resize(std::max(m_buffer.size() * 2, m_used + recordLength));
+            }
+
+            char * const record = m_buffer.data() + m_used;
+            std::memset(record, m_padding, recordLength - m_terminator.size());
+            std::memcpy(record + recordLength - m_terminator.size(), m_terminator.data(), m_terminator.size());
+            for(std::size_t c = 0; c < columns.size(); ++c)
+            {
+                if(fields[c].size() > columns[c].width)
+                {
+                    throw std::invalid_argument("writeRecord(): \"" + std::string(fields[c]) + "\" is wider than its column");
+                }
+                const std::size_t shift = (columns[c].align == FieldAlign::right) ? columns[c].width - fields[c].size() : 0;
+                std::memcpy(record + columns[c].offset + shift, fields[c].data(), fields[c].size());
+            }
+            m_used += recordLength;
+        }
+
+        void writeRecord( std::initializer_list<std::string_view> fields )
+        {
+            writeRecord(std::span<const std::string_view>(fields.begin(), fields.size()));
+        }
+
+        /**
+         * The records written so far.
+         */
+        std::string_view view() const
+        {
+            return std::string_view(m_buffer.data(), m_used);
+        }
+
+        std::size_t recordCount() const
+        {
+            return m_used / m_layout.recordLength();
+        }
+
+        /**
+         * Returns the records written so far and leaves the writer empty.
+         */
+        std::string release()
+        {
+            m_buffer.resize(m_used);
+            m_used = 0;
+            return std::move(m_buffer);
+        }
+
+    private:
+        FixedWidthLayout m_layout;
+        char m_padding;
+        std::string m_terminator;
+        std::string m_buffer;
+        std::size_t m_used = 0;
+    };
+
+
+    namespace detail
+    {
+        /**
+         * A string being sorted by sortStrings(), with the 8 bytes of it starting at the current depth cached as a
+         * big-endian integer, so most comparisons are a single integer comparison that does not touch the string.
+         */
+        struct StringSortEntry
+        {
+            std::uint64_t key;
+            std::string_view str;
+            std::size_t index;
+        };
+
+
+        /**
+         * Returns the 8 bytes of str starting at depth as a big-endian integer, padded with zeros past the end of str.
+         */
+        std::uint64_t stringPrefixKey(  std::string_view str,
+                                        std::size_t depth   )
+        {
+            if(str.size() >= depth + 8)
+            {
+                const std::uint64_t word = load64(str.data() + depth);
+                if constexpr(std::endian::native == std::endian::little)
+                {
+                    return std::byteswap(word);
+                }
+                else
+                {
+                    return word;
+                }
+            }
+            std::uint64_t key = 0;
+            for(std::size_t i = depth; i < depth + 8; ++i)
+            {
+                key = (key << 8) | ((i < str.size()) ? static_cast<unsigned char>(str[i]) : 0);
+            }
+            return key;
+        }
+
+
+        /**
+         * Sorts entries that all share their first depth bytes by insertion, for small groups.
+         */
+        void insertionSortStrings(  StringSortEntry * entries,
+                                    std::size_t count,
+                                    std::size_t depth   )
+        {
+            for(std::size_t i = 1; i < count; ++i)
+            {
+                StringSortEntry entry = entries[i];
+                std::size_t j = i;
+                while((j > 0) && ((entry.key < entries[j - 1].key)
+                                  || ((entry.key == entries[j - 1].key) && (entry.str.substr(depth) < entries[j - 1].str.substr(depth)))))
+                {
+                    entries[j] = entries[j - 1];
+                    --j;
+                }
+                entries[j] = entry;
+            }
+        }
+
+
+        /**
+         * The recursion budget of multikeyQuicksort() for count entries: 2 * log2(count), as in introsort.
+         */
+        unsigned sortBudget( std::size_t count )
+        {
+            return 2 * static_cast<unsigned>(std::bit_width(count));
+        }
+
+
+        /**
+         * Multikey quicksort (Bentley and Sedgewick) on 8-byte keys: entries are split three ways around a pivot key,
+         * the smaller and larger parts are sorted at the same depth, and the part equal to the pivot moves on to the
+         * next 8 bytes. Strings that end within the current key are prefixes of the others in their part, so they go
+         * first, ordered by length.
+         *
+         * As in introsort, each level of recursion spends one unit of budget, and a part reached with none left is
+         * sorted with std::sort, so bad pivots cannot make the recursion deeper than the initial budget.
+         */
+        void multikeyQuicksort(     StringSortEntry * entries,
+                                    std::size_t count,
+                                    std::size_t depth,
+                                    unsigned budget     )
+        {
+            while(count > 16)
+            {
+                if(budget == 0)
+                {
+                    std::sort(entries, entries + count, [depth](const StringSortEntry & x, const StringSortEntry & y)
+                    {
+                        return x.str.substr(depth) < y.str.substr(depth);
+                    });
+                    return;
+                }
+
+                const std::uint64_t a = entries[0].key;
+                const std::uint64_t b = entries[count / 2].key;
+                const std::uint64_t c = entries[count - 1].key;
+                const std::uint64_t pivot = std::max(std::min(a, b), std::min(std::max(a, b), c));
+
+                std::size_t less = 0;
+                std::size_t i = 0;
+                std::size_t greater = count;
+                while(i < greater)
+                {
+                    if(entries[i].key < pivot)
+                    {
+                        std::swap(entries[less++], entries[i++]);
+                    }
+                    else if(entries[i].key > pivot)
+                    {
+                        std::swap(entries[i], entries[--greater]);
+                    }
+                    else
+                    {
+                        ++i;
+                    }
+                }
+                multikeyQuicksort(entries, less, depth, budget - 1);
+                multikeyQuicksort(entries + greater, count - greater, depth, budget - 1);
+
+                StringSortEntry * const equal = entries + less;
+                StringSortEntry * const equalEnd = entries + greater;
+                StringSortEntry * const unfinished = std::partition(equal, equalEnd, [depth](const StringSortEntry & entry)
+                {
+                    return entry.str.size() <= depth + 8;
+                });
+                std::sort(equal, unfinished, [](const StringSortEntry & x, const StringSortEntry & y)
+                {
+                    return x.str.size() < y.str.size();
+                });
+
+                entries = unfinished;
+                count = equalEnd - unfinished;
+                depth += 8;
+                for(std::size_t k = 0; k < count; ++k)
+                {
+                    entries[k].key = stringPrefixKey(entries[k].str, depth);
+                }
+            }
+            insertionSortStrings(entries, count, depth);
+        }
+
+
+        /**
+         * Sorts the entries by their strings. Large inputs are split into buckets by their first key, using splitters
+         * taken from a sample, and the buckets are sorted by threadCount threads.
+         */
+        void sortStringEntries(     std::vector<StringSortEntry> & entries,
+                                    unsigned threadCount    )
+        {
+            for(StringSortEntry & entry : entries)
+            {
+                entry.key = stringPrefixKey(entry.str, 0);
+            }
+            if(threadCount == 0)
+            {
+                threadCount = std::max(1u, std::thread::hardware_concurrency());
+            }
+            if((threadCount == 1) || (entries.size() < (1 << 16)))
+            {
+                multikeyQuicksort(entries.data(), entries.size(), 0, sortBudget(entries.size()));
+                return;
+            }
+
+            //Several buckets per thread even out their sizes. Equal keys always land in the same bucket.
+            const std::size_t bucketCount = threadCount * 8;
+            std::vector<std::uint64_t> splitters;
+            const std::size_t sampleSize = bucketCount * 32;
+            for(std::size_t i = 0; i < sampleSize; ++i)
+            {
+                splitters.push_back(entries[i * entries.size() / sampleSize].key);
+            }
+            std::sort(splitters.begin(), splitters.end());
+            for(std::size_t b = 1; b < bucketCount; ++b)
+            {
+                splitters[b - 1] = splitters[b * sampleSize / bucketCount];
+            }
+            splitters.resize(bucketCount - 1);
+
+            std::vector<std::uint32_t> buckets(entries.size());
+            std::vector<std::size_t> bucketBegin(bucketCount + 1, 0);
+            for(std::size_t i = 0; i < entries.size(); ++i)
+            {
+                buckets[i] = static_cast<std::uint32_t>(std::upper_bound(splitters.begin(), splitters.end(), entries[i].key) - splitters.begin());
+                ++bucketBegin[buckets[i] + 1];
+            }
+            for(std::size_t b = 0; b < bucketCount; ++b)
+            {
+                bucketBegin[b + 1] += bucketBegin[b];
+            }
+            std::vector<StringSortEntry> scattered(entries.size());
+            std::vector<std::size_t> next(bucketBegin.begin(), bucketBegin.end() - 1);
+            for(std::size_t i = 0; i < entries.size(); ++i)
+            {
+                scattered[next[buckets[i]]++] = entries[i];
+            }
+            entries.swap(scattered);
+
+            std::atomic<std::size_t> nextBucket = 0;
+            std::vector<std::thread> threads;
+            for(unsigned t = 0; t < threadCount; ++t)
+            {
+                threads.emplace_back([&]()
+                {
+                    for(std::size_t b = nextBucket++; b < bucketCount; b = nextBucket++)
+                    {
+                        const std::size_t bucketSize = bucketBegin[b + 1] - bucketBegin[b];
+                        multikeyQuicksort(entries.data() + bucketBegin[b], bucketSize, 0, sortBudget(bucketSize));
+                    }
+                });
+            }
+            for(std::thread & thread : threads)
+            {
+                thread.join();
+            }
+        }
+
+
+        template<typename Strings>
+        std::vector<StringSortEntry> makeStringSortEntries( const Strings & strings )
+        {
+            std::vector<StringSortEntry> entries(strings.size());
+            for(std::size_t i = 0; i < strings.size(); ++i)
+            {
+                entries[i].str = strings[i];
+                entries[i].index = i;
+            }
+            return entries;
+        }
+    }
+
+
+    /**
+     * Sorts string views in byte order, several times faster than std::sort() on large inputs. It is a multikey
+     * quicksort that compares 8 cached bytes of each string at a time, so it rarely reads the strings themselves and
+     * never compares the prefix two strings share more than once. Large inputs are sorted in parallel.
+     *
+     * @param strings - The views to sort in place.
+     * @param threadCount - The number of threads to use, or 0 to use one per hardware thread.
+     */
+    void sortStrings(   std::span<std::string_view> strings,
+                        unsigned threadCount = 0    )
+    {
+        std::vector<detail::StringSortEntry> entries = detail::makeStringSortEntries(strings);
+        detail::sortStringEntries(entries, threadCount);
+        for(std::size_t i = 0; i < entries.size(); ++i)
+        {
+            strings[i] = entries[i].str;
+        }
+    }
+
+
+    /**
+     * Sorts strings in byte order, as sortStrings() sorts string views. The strings themselves are only moved once,
+     * to their final place.
+     *
+     * @param strings - The strings to sort in place.
+     * @param threadCount - The number of threads to use, or 0 to use one per hardware thread.
+     */
+    void sortStrings(   std::vector<std::string> & strings,
+                        unsigned threadCount = 0    )
+    {
+        std::vector<detail::StringSortEntry> entries = detail::makeStringSortEntries(strings);
+        detail::sortStringEntries(entries, threadCount);
+        std::vector<std::string> sorted(strings.size());
+        for(std::size_t i = 0; i < entries.size(); ++i)
+        {
+            sorted[i] = std::move(strings[entries[i].index]);
+        }
+        strings.swap(sorted);
+    }
+
+
+    /**
+     * Sorts strings with sortStrings() and removes the duplicates, like "sort | uniq".
+     *
+     * @param strings - The strings to sort and deduplicate in place.
+     * @param threadCount - The number of threads to use, or 0 to use one per hardware thread.
+     *
+     * @retval std::size_t - The number of unique strings left.
+     */
+    std::size_t sortUnique(     std::vector<std::string> & strings,
+                                unsigned threadCount = 0    )
+    {
+        sortStrings(strings, threadCount);
+        strings.erase(std::unique(strings.begin(), strings.end()), strings.end());
+        return strings.size();
+    }
+
+
+    /**
+     * Sorts string views with sortStrings() and removes the duplicates.
+     *
+     * @param strings - The views to sort and deduplicate in place.
+     * @param threadCount - The number of threads to use, or 0 to use one per hardware thread.
+     *
+     * @retval std::size_t - The number of unique views left.
+     */
+    std::size_t sortUnique(     std::vector<std::string_view> & strings,
+                                unsigned threadCount = 0    )
+    {
+        sortStrings(std::span<std::string_view>(strings), threadCount);
+        strings.erase(std::unique(strings.begin(), strings.end()), strings.end());
+        return strings.size();
+    }
+
+
+    namespace detail
+    {
+        //The default secret of wyhash
+        constexpr std::uint64_t hashSecret[4] = {   0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL,
+                                                    0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL   };
+
+
+        /**
+         * Loads 8 or 4 bytes as a little-endian integer, so that hashes are the same on every platform.
+         */
+        std::uint64_t loadLittle64( const char * p )
+        {
+            const std::uint64_t word = load64(p);
+            if constexpr(std::endian::native == std::endian::little)
+            {
+                return word;
+            }
+            else
+            {
+                return std::byteswap(word);
+            }
+        }
+
+        std::uint64_t loadLittle32( const char * p )
+        {
+            std::uint32_t word;
+            std::memcpy(&word, p, sizeof(word));
+            if constexpr(std::endian::native == std::endian::little)
+            {
+                return word;
+            }
+            else
+            {
+                return std::byteswap(word);
+            }
+        }
+
+
+        /**
+         * Multiplies a and b into 128 bits, leaving the low half in a and the high half in b.
+         */
+        void multiply128(   std::uint64_t & a,
+                            std::uint64_t & b   )
+        {
+#ifdef __SIZEOF_INT128__
+            const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+            a = static_cast<std::uint64_t>(product);
+            b = static_cast<std::uint64_t>(product >> 64);
+#else
+            const std::uint64_t aHigh = a >> 32;
+            const std::uint64_t aLow = static_cast<std::uint32_t>(a);
+            const std::uint64_t bHigh = b >> 32;
+            const std::uint64_t bLow = static_cast<std::uint32_t>(b);
+            const std::uint64_t low = aLow * bLow;
+            const std::uint64_t middle1 = aHigh * bLow;
+            const std::uint64_t middle2 = aLow * bHigh;
+            const std::uint64_t high = aHigh * bHigh;
+            const std::uint64_t carry = ((low >> 32) + static_cast<std::uint32_t>(middle1) + static_cast<std::uint32_t>(middle2)) >> 32;
+            a = low + (middle1 << 32) + (middle2 << 32);
+            b = high + (middle1 >> 32) + (middle2 >> 32) + carry;
+#endif
+        }
+
+
+        /**
+         * Folds the 128-bit product of a and b into 64 bits.
+         */
+        std::uint64_t hashMix(  std::uint64_t a,
+                                std::uint64_t b     )
+        {
+            multiply128(a, b);
+            return a ^ b;
+        }
+    }
+
+
+    /**
+     * Hashes a string with the wyhash algorithm (final version 4): a fast, well-distributed, non-cryptographic hash
+     * that mixes 16 bytes per 64x64->128-bit multiplication, and three independent streams of them for long strings.
+     * Unlike std::hash, the result is the same on every platform and with every standard library, so it can be stored.
+     * Short strings, the common case for tokens, are read with at most four overlapping loads and no loop.
+     *
+     * Do not use it where an attacker chooses the strings and can benefit from collisions; the seed only makes that
+     * harder if it is kept secret.
+     *
+     * @param str - The string to hash.
+     * @param seed - Gives a different, independent hash function for each value.
+     *
+     * @retval std::uint64_t - The hash of str.
+     */
+    std::uint64_t hashString(   std::string_view str,
+                                std::uint64_t seed = 0  )
+    {
+        using detail::hashSecret;
+        const char * p = str.data();
+        const std::size_t length = str.size();
+        seed ^= detail::hashMix(seed ^ hashSecret[0], hashSecret[1]);
+        std::uint64_t a = 0;
+        std::uint64_t b = 0;
+        if(length <= 16)
+        {
+            if(length >= 4)
+            {
+                //Two pairs of 4-byte loads, overlapping as needed, cover any length from 4 to 16
+                const std::size_t offset = (length >> 3) << 2;
+                a = (detail::loadLittle32(p) << 32) | detail::loadLittle32(p + offset);
+                b = (detail::loadLittle32(p + length - 4) << 32) | detail::loadLittle32(p + length - 4 - offset);
+            }
+            else if(length > 0)
+            {
+                a = (static_cast<std::uint64_t>(static_cast<unsigned char>(p[0])) << 16)
+                  | (static_cast<std::uint64_t>(static_cast<unsigned char>(p[length >> 1])) << 8)
+                  | static_cast<unsigned char>(p[length - 1]);
+            }
+        }
+        else
+        {
+            std::size_t remaining = length;
+            if(remaining > 48)
+            {
+                std::uint64_t seed1 = seed;
+                std::uint64_t seed2 = seed;
+                do
+                {
+                    seed = detail::hashMix(detail::loadLittle64(p) ^ hashSecret[1], detail::loadLittle64(p + 8) ^ seed);
+                    seed1 = detail::hashMix(detail::loadLittle64(p + 16) ^ hashSecret[2], detail::loadLittle64(p + 24) ^ seed1);
+                    seed2 = detail::hashMix(detail::loadLittle64(p + 32) ^ hashSecret[3], detail::loadLittle64(p + 40) ^ seed2);
+                    p += 48;
+                    remaining -= 48;
+                }
+                while(remaining > 48);
+                seed ^= seed1 ^ seed2;
+            }
+            while(remaining > 16)
+            {
+                seed = detail::hashMix(detail::loadLittle64(p) ^ hashSecret[1], detail::loadLittle64(p + 8) ^ seed);
+                p += 16;
+                remaining -= 16;
+            }
+            a = detail::loadLittle64(p + remaining - 16);
+            b = detail::loadLittle64(p + remaining - 8);
+        }
+        a ^= hashSecret[1];
+        b ^= seed;
+        detail::multiply128(a, b);
+        return detail::hashMix(a ^ hashSecret[0] ^ length, b ^ hashSecret[1]);
+    }
+
+
+    /**
+     * Hashes many strings with hashString(). The strings are independent, so the processor overlaps the
+     * multiplications of consecutive strings.
+     *
+     * Throws std::invalid_argument if hashes is not the size of strings.
+     *
+     * @param strings - The strings to hash.
+     * @param hashes - Receives the hash of each string.
+     * @param seed - Gives a different, independent hash function for each value.
+     */
+    template<typename Str>
+    requires std::convertible_to<const Str &, std::string_view>
+    void hashStrings(   std::span<const Str> strings,
+                        std::span<std::uint64_t> hashes,
+                        std::uint64_t seed = 0  )
+    {
+        if(hashes.size() != strings.size())
+        {
+            throw std::invalid_argument("hashStrings(): hashes must have one element per string");
+        }
+        for(std::size_t i = 0; i < strings.size(); ++i)
+        {
+            hashes[i] = hashString(strings[i], seed);
+        }
+    }
+
+
+    /**
+     * Hashes many strings with hashString(), returning the hashes.
+     */
+    template<typename Str>
+    requires std::convertible_to<const Str &, std::string_view>
+    std::vector<std::uint64_t> hashStrings(     const std::vector<Str> & strings,
+                                                std::uint64_t seed = 0  )
+    {
+        std::vector<std::uint64_t> hashes(strings.size());
+        hashStrings(std::span<const Str>(strings), std::span<std::uint64_t>(hashes), seed);
+        return hashes;
+    }
+
+
+    /**
+     * A hash function object for standard unordered containers keyed by std::string, using hashString(). It is
+     * transparent, so with std::equal_to<> the container can be searched with a std::string_view or a C string
+     * without building a std::string, e.g.
+     *
+     * std::unordered_map<std::string, int, StringHash, std::equal_to<>> counts;
+     * counts.find(std::string_view("word"));
+     */
+    struct StringHash
+    {
+        using is_transparent = void;
+
+        std::size_t operator()( std::string_view str ) const
+        {
+            return static_cast<std::size_t>(hashString(str));
+        }
+
+        std::size_t operator()( const std::string & str ) const
+        {
+            return static_cast<std::size_t>(hashString(str));
+        }
+
+        std::size_t operator()( const char * str ) const
+        {
+            return static_cast<std::size_t>(hashString(str));
+        }
+    };
+
+
+    /**
+     * Counts the occurrences of tokens. The tokens are string views, so the table never copies them, and they must
+     * outlive it. The table is a flat array of slots with open addressing and linear probing, which keeps lookups to
+     * one or two cache lines, and tokens are hashed with hashString().
+     */
+    class TokenFrequencyTable
+    {
+    public:
+        explicit TokenFrequencyTable( std::size_t expectedTokens = 0 )
+        {
+            m_slots.resize(std::bit_ceil(std::max<std::size_t>(16, expectedTokens * 2)));
+        }
+
+        /**
+         * Adds count occurrences of a token.
+         */
+        void add(   std::string_view token,
+                    std::size_t count = 1   )
+        {
+            if(count == 0)
+            {
+                return;
+            }
+            //Keep the load factor under 1/2 so probe sequences stay short
+            if(2 * (m_size + 1) > m_slots.size())
+            {
+                grow();
+            }
+            const std::uint64_t hash = hashString(token);
+            Slot & slot = m_slots[findSlot(token, hash)];
+            if(slot.count == 0)
+            {
+                slot.token = token;
+                slot.hash = hash;
+                ++m_size;
+            }
+            slot.count += count;
+            m_total += count;
+        }
+
+        /**
+         * Returns the number of occurrences of a token, which is 0 if it was never added.
+         */
+        std::size_t count( std::string_view token ) const
+        {
+            return m_slots[findSlot(token, hashString(token))].count;
+        }
+
+        /**
+         * The number of distinct tokens.
+         */
+        std::size_t size() const
+        {
+            return m_size;
+        }
+
+        /**
+         * The number of occurrences of all tokens.
+         */
+        std::size_t totalCount() const
+        {
+            return m_total;
+        }
+
+        /**
+         * Adds the counts of another table to this one.
+         */
+        void merge( const TokenFrequencyTable & other )
+        {
+            for(const Slot & slot : other.m_slots)
+            {
+                if(slot.count != 0)
+                {
+                    add(slot.token, slot.count);
+                }
+            }
+        }
+
+        /**
+         * Calls callback(std::string_view token, std::size_t count) for each distinct token, in no particular order.
+         */
+        template<typename Callback>
+        void forEach( Callback && callback ) const
+        {
+            for(const Slot & slot : m_slots)
+            {
+                if(slot.count != 0)
+                {
+                    callback(slot.token, slot.count);
+                }
+            }
+        }
+
+        /**
+         * Returns the k most frequent tokens, most frequent first, with ties in byte order. Only a heap of k tokens is
+         * kept while scanning the table, instead of sorting all of it.
+         */
+        std::vector<std::pair<std::string_view, std::size_t>> topK( std::size_t k ) const
+        {
+            using Entry = std::pair<std::string_view, std::size_t>;
+            auto moreFrequent = [](const Entry & a, const Entry & b)
+            {
+                return (a.second > b.second) || ((a.second == b.second) && (a.first < b.first));
+            };
+            //With moreFrequent as the ordering, the top of the heap is the least frequent of the tokens kept
+            std::vector<Entry> heap;
+            heap.reserve(std::min(k, m_size) + 1);
+            if(k == 0)
+            {
+                return heap;
+            }
+            for(const Slot & slot : m_slots)
+            {
+                if(slot.count == 0)
+                {
+                    continue;
+                }
+                const Entry entry(slot.token, slot.count);
+                if(heap.size() < k)
+                {
+                    heap.push_back(entry);
+                    std::push_heap(heap.begin(), heap.end(), moreFrequent);
+                }
+                else if(moreFrequent(entry, heap.front()))
+                {
+                    std::pop_heap(heap.begin(), heap.end(), moreFrequent);
+                    heap.back() = entry;
+                    std::push_heap(heap.begin(), heap.end(), moreFrequent);
+                }
+            }
+            std::sort_heap(heap.begin(), heap.end(), moreFrequent);
+            return heap;
+        }
+
+    private:
+        struct Slot
+        {
+            std::string_view token;
+            std::uint64_t hash = 0;
+            //0 marks an empty slot
+            std::size_t count = 0;
+        };
+
+        /**
+         * Returns the index of the slot holding a token, or of the empty slot where it would go.
+         */
+        std::size_t findSlot(   std::string_view token,
+                                std::uint64_t hash  ) const
+        {
+            const std::size_t mask = m_slots.size() - 1;
+            for(std::size_t i = hash & mask;; i = (i + 1) & mask)
+            {
+                const Slot & slot = m_slots[i];
+                if((slot.count == 0) || ((slot.hash == hash) && (slot.token == token)))
+                {
+                    return i;
+                }
+            }
+        }
+
+        void grow()
+        {
+            std::vector<Slot> slots(m_slots.size() * 2);
+            m_slots.swap(slots);
+            const std::size_t mask = m_slots.size() - 1;
+            for(const Slot & slot : slots)
+            {
+                if(slot.count != 0)
+                {
+                    std::size_t i = slot.hash & mask;
+                    while(m_slots[i].count != 0)
+                    {
+                        i = (i + 1) & mask;
+                    }
+                    m_slots[i] = slot;
+                }
+            }
+        }
+
+        std::vector<Slot> m_slots;
+        std::size_t m_size = 0;
+        std::size_t m_total = 0;
+    };
+
+
+    namespace detail
+    {
+        /**
+         * Adds the tokens of text, runs of characters that are not delimiters, to a table.
+         */
+        void countTokensInto(   std::string_view text,
+                                const std::array<bool, 256> & isDelimiter,
+                                TokenFrequencyTable & table     )
+        {
+            std::size_t i = 0;
+            while(i < text.size())
+            {
+                while((i < text.size()) && isDelimiter[static_cast<unsigned char>(text[i])])
+                {
+                    ++i;
+                }
+                const std::size_t begin = i;
+                while((i < text.size()) && !isDelimiter[static_cast<unsigned char>(text[i])])
+                {
+                    ++i;
+                }
+                if(i != begin)
+                {
+                    table.add(text.substr(begin, i - begin));
+                }
+            }
+        }
+    }
+
+
+    /**
+     * Splits text into tokens and counts them in a single pass, without copying any token: the table holds views into
+     * text, which must outlive it. A token is a run of characters that are not delimiters, so, unlike separate(), no
+     * empty tokens are produced.
+     *
+     * With several threads, text is cut into chunks at delimiters, each thread counts its chunk in its own table, and
+     * the tables are merged.
+     *
+     * @param text - The text to count the tokens of.
+     * @param delimiters - The characters separating tokens.
+     * @param threadCount - The number of threads to use, or 0 to use one per hardware thread.
+     *
+     * @retval TokenFrequencyTable - The number of occurrences of each token.
+     */
+    TokenFrequencyTable countTokens(    std::string_view text,
+                                        std::string_view delimiters = " \t\n\r\v\f",
+                                        unsigned threadCount = 1    )
+    {
+        std::array<bool, 256> isDelimiter{};
+        for(char c : delimiters)
+        {
+            isDelimiter[static_cast<unsigned char>(c)] = true;
+        }
+        if(threadCount == 0)
+        {
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+        //One thread per started 64 KiB of text at most: on smaller chunks, starting a thread costs more than it saves
+        threadCount = static_cast<unsigned>(std::min<std::size_t>(threadCount, text.size() / (1 << 16) + 1));
+
+        TokenFrequencyTable table(text.size() / 64);
+        if(threadCount == 1)
+        {
+            detail::countTokensInto(text, isDelimiter, table);
+            return table;
+        }
+
+        //Move each cut forward to a delimiter so that no token is split between two chunks
+        std::vector<std::size_t> cuts(threadCount + 1, text.size());
+        cuts[0] = 0;
+        for(unsigned t = 1; t < threadCount; ++t)
+        {
+            std::size_t cut = std::max(cuts[t - 1], text.size() * t / threadCount);
+            while((cut < text.size()) && !isDelimiter[static_cast<unsigned char>(text[cut])])
+            {
+                ++cut;
+            }
+            cuts[t] = cut;
+        }
+        std::vector<TokenFrequencyTable> tables;
+        for(unsigned t = 0; t < threadCount; ++t)
+        {
+            tables.emplace_back((cuts[t + 1] - cuts[t]) / 64);
+        }
+        std::vector<std::thread> threads;
+        for(unsigned t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back([&, t]()
+            {
+                detail::countTokensInto(text.substr(cuts[t], cuts[t + 1] - cuts[t]), isDelimiter, tables[t]);
+            });
+        }
+        for(std::thread & thread : threads)
+        {
+            thread.join();
+        }
+        for(const TokenFrequencyTable & partial : tables)
+        {
+            table.merge(partial);
+        }
+        return table;
+    }
+
+
+    namespace detail
+    {
+        //Rolling hashes are computed modulo the Mersenne prime 2^61 - 1, where reduction is a shift and an add
+        constexpr std::uint64_t mersenne61 = (1ULL << 61) - 1;
+
+
+        std::uint64_t multiplyMod61(    std::uint64_t a,
+                                        std::uint64_t b     )
+        {
+            multiply128(a, b);
+            //The product is b * 2^64 + a, and 2^64 = 8 * 2^61 = 8 modulo 2^61 - 1
+            std::uint64_t r = (a & mersenne61) + (a >> 61) + (b << 3);
+            r = (r & mersenne61) + (r >> 61);
+            return (r >= mersenne61) ? r - mersenne61 : r;
+        }
+
+
+        std::uint64_t addMod61(     std::uint64_t a,
+                                    std::uint64_t b     )
+        {
+            const std::uint64_t r = a + b;
+            return (r >= mersenne61) ? r - mersenne61 : r;
+        }
+    }
+
+
+    /**
+     * The polynomial hashes of all the windows of a fixed length in a text (Rabin-Karp rolling hashes), as a range of
+     * {position, hash} in order of position. Moving to the next window takes constant time, whatever its length:
+     * the byte leaving the window is taken out of the hash and the byte entering it is added. Hashes are computed
+     * modulo the prime 2^61 - 1, so two different windows collide with a probability of about window / 2^61.
+     *
+     * The text must outlive the range. Throws std::invalid_argument if window is 0.
+     *
+     * for(RollingHash::Window w : RollingHash(text, 8)) ...
+     */
+    class RollingHash
+    {
+    public:
+        struct Window
+        {
+            std::size_t position;
+            std::uint64_t hash;
+        };
+
+        class iterator
+        {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = Window;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const Window *;
+            using reference = const Window &;
+
+            iterator() = default;
+
+            reference operator*() const
+            {
+                return m_current;
+            }
+
+            pointer operator->() const
+            {
+                return &m_current;
+            }
+
+            iterator & operator++()
+            {
+                const RollingHash & r = *m_parent;
+                const std::size_t leaving = m_current.position;
+                ++m_current.position;
+                if(m_current.position + r.m_window <= r.m_text.size())
+                {
+                    const std::uint64_t removed = detail::multiplyMod61(byteValue(r.m_text[leaving]), r.m_leadingPower);
+                    const std::uint64_t remaining = detail::addMod61(m_current.hash, detail::mersenne61 - removed);
+                    m_current.hash = detail::addMod61(detail::multiplyMod61(remaining, r.m_base), byteValue(r.m_text[leaving + r.m_window]));
+                }
+                return *this;
+            }
+
+            iterator operator++( int )
+            {
+                iterator previous = *this;
+                ++*this;
+                return previous;
+            }
+
+            friend bool operator==(     const iterator & a,
+                                        const iterator & b  )
+            {
+                return a.m_current.position == b.m_current.position;
+            }
+
+        private:
+            friend class RollingHash;
+
+            iterator(   const RollingHash * parent,
+                        Window current  )
+                : m_parent(parent),
+                  m_current(current)
+            {
+            }
+
+            const RollingHash * m_parent = nullptr;
+            Window m_current{0, 0};
+        };
+
+        RollingHash(    std::string_view text,
+                        std::size_t window,
+                        std::uint64_t base = 0x1F2E3D4C5B6A7988ULL % detail::mersenne61   )
+            : m_text(text),
+              m_window(window),
+              m_base(base % detail::mersenne61)
+        {
+            if(window == 0)
+            {
+                throw std::invalid_argument("RollingHash(): the window cannot be empty");
+            }
+            m_leadingPower = 1;
+            for(std::size_t i = 1; i < window; ++i)
+            {
+                m_leadingPower = detail::multiplyMod61(m_leadingPower, m_base);
+            }
+        }
+
+        /**
+         * Returns the hash a window holding str would have, for a str of any length.
+         */
+        std::uint64_t hashOf( std::string_view str ) const
+        {
+            std::uint64_t hash = 0;
+            for(char c : str)
+            {
+                hash = detail::addMod61(detail::multiplyMod61(hash, m_base), byteValue(c));
+            }
+            return hash;
+        }
+
+        std::size_t window() const
+        {
+            return m_window;
+        }
+
+        /**
+         * The number of windows, which is 0 if the text is shorter than a window.
+         */
+        std::size_t size() const
+        {
+            return (m_text.size() >= m_window) ? m_text.size() - m_window + 1 : 0;
+        }
+
+        iterator begin() const
+        {
+            if(size() == 0)
+            {
+                return end();
+            }
+            return iterator(this, Window{0, hashOf(m_text.substr(0, m_window))});
+        }
+
+        iterator end() const
+        {
+            return iterator(this, Window{size(), 0});
+        }
+
+    private:
+        /**
+         * Bytes count from 1 so that windows of zero bytes do not all hash to 0.
+         */
+        static std::uint64_t byteValue( char c )
+        {
+            return static_cast<std::uint64_t>(static_cast<unsigned char>(c)) + 1;
+        }
+
+        std::string_view m_text;
+        std::size_t m_window;
+        std::uint64_t m_base;
+        //base^(window - 1), the weight of the byte leaving the window
+        std::uint64_t m_leadingPower;
+    };
+
+
+    /**
+     * A substring found again by findRepeats(): the window at position is equal to the one at firstPosition.
+     */
+    struct Repeat
+    {
+        std::size_t position;
+        std::size_t firstPosition;
+    };
+
+
+    /**
+     * Finds the substrings of length k that occur more than once in a text, e.g. boilerplate repeated across scraped
+     * pages. Each window of the text is looked up by its rolling hash in a flat set of the windows seen so far, and a
+     * match is confirmed by comparing the bytes, so no false repeats are reported.
+     *
+     * Throws std::invalid_argument if k is 0.
+     *
+     * @param text - The text to search.
+     * @param k - The length of the substrings.
+     *
+     * @retval std::vector<Repeat> - For each window equal to an earlier one, its position and the position of the first
+     *                               occurrence, in order of position.
+     */
+    std::vector<Repeat> findRepeats(    std::string_view text,
+                                        std::size_t k   )
+    {
+        const RollingHash hashes(text, k);
+        std::vector<Repeat> repeats;
+        if(hashes.size() == 0)
+        {
+            return repeats;
+        }
+
+        //Open addressing with linear probing; a slot holds a window's hash and position, and an empty slot holds npos
+        struct Slot
+        {
+            std::uint64_t hash;
+            std::size_t position;
+        };
+        const std::size_t capacity = std::bit_ceil(2 * hashes.size());
+        const std::size_t mask = capacity - 1;
+        std::vector<Slot> slots(capacity, Slot{0, std::string_view::npos});
+        for(const RollingHash::Window & window : hashes)
+        {
+            //The low bits of the hash are well mixed by the multiplications modulo 2^61 - 1
+            std::size_t i = (window.hash ^ (window.hash >> 29)) & mask;
+            while(true)
+            {
+                Slot & slot = slots[i];
+                if(slot.position == std::string_view::npos)
+                {
+                    slot = Slot{window.hash, window.position};
+                    break;
+                }
+                if((slot.hash == window.hash) && (std::memcmp(text.data() + slot.position, text.data() + window.position, k) == 0))
+                {
+                    repeats.push_back(Repeat{window.position, slot.position});
+                    break;
+                }
+                i = (i + 1) & mask;
+            }
+        }
+        return repeats;
+    }
+
+
+    /**
+     * An occurrence found by findAllPatterns(): patterns[pattern] occurs in the text at position.
+     */
+    struct PatternMatch
+    {
+        std::size_t position;
+        std::size_t pattern;
+    };
+
+
+    /**
+     * Finds all the occurrences of many patterns of the same length in a single pass over a text (multi-pattern
+     * Rabin-Karp). The rolling hash of each window is looked up in a table of the patterns' hashes, and a match is
+     * confirmed by comparing the bytes. The cost barely depends on the number of patterns, unlike calling findAll()
+     * for each of them.
+     *
+     * Throws std::invalid_argument if the patterns are empty or do not all have the same length.
+     *
+     * @param text - The text to search.
+     * @param patterns - The patterns to find, all of the same, non-zero length.
+     *
+     * @retval std::vector<PatternMatch> - The occurrences, in order of position, then of pattern index.
+     */
+    std::vector<PatternMatch> findAllPatterns(  std::string_view text,
+                                                std::span<const std::string_view> patterns  )
+    {
+        std::vector<PatternMatch> matches;
+        if(patterns.empty())
+        {
+            return matches;
+        }
+        const std::size_t k = patterns[0].size();
+        for(std::string_view pattern : patterns)
+        {
+            if((pattern.size() != k) || (k == 0))
+            {
+                throw std::invalid_argument("findAllPatterns(): the patterns must all have the same, non-zero length");
+            }
+        }
+        const RollingHash hashes(text, k);
+
+        //Each slot starts a chain of the patterns sharing its hash bucket, linked through nextPattern in index order
+        const std::size_t capacity = std::bit_ceil(2 * patterns.size());
+        const std::size_t mask = capacity - 1;
+        constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+        std::vector<std::size_t> firstPattern(capacity, none);
+        std::vector<std::size_t> nextPattern(patterns.size(), none);
+        std::vector<std::uint64_t> patternHashes(patterns.size());
+        for(std::size_t p = patterns.size(); p-- > 0;)
+        {
+            patternHashes[p] = hashes.hashOf(patterns[p]);
+            const std::size_t bucket = (patternHashes[p] ^ (patternHashes[p] >> 29)) & mask;
+            nextPattern[p] = firstPattern[bucket];
+            firstPattern[bucket] = p;
+        }
+
+        for(const RollingHash::Window & window : hashes)
+        {
+            for(std::size_t p = firstPattern[(window.hash ^ (window.hash >> 29)) & mask]; p != none; p = nextPattern[p])
+            {
+                if((patternHashes[p] == window.hash) && (std::memcmp(text.data() + window.position, patterns[p].data(), k) == 0))
+                {
+                    matches.push_back(PatternMatch{window.position, p});
+                }
+            }
+        }
+        return matches;
+    }
+
+
+    namespace detail
+    {
+        /**
+         * Builds the suffix array of s, whose values are in [0, upper], with SA-IS (Nong, Zhang and Chan), in linear
+         * time. This follows the AtCoder Library implementation: suffixes are classified as S or L, the LMS suffixes
+         * are sorted by induced sorting, and if some LMS substrings are equal, their order is settled by recursing
+         * on the string of their ranks. Index must be signed, as -1 marks empty slots.
+         */
+        template<typename Index>
+        std::vector<Index> suffixArraySais(     const std::vector<Index> & s,
+                                                Index upper     )
+        {
+            const Index n = static_cast<Index>(s.size());
+            if(n == 0)
+            {
+                return {};
+            }
+            if(n == 1)
+            {
+                return {0};
+            }
+            if(n == 2)
+            {
+                return (s[0] < s[1]) ? std::vector<Index>{0, 1} : std::vector<Index>{1, 0};
+            }
+
+            std::vector<Index> sa(n);
+            //ls[i] is true for S suffixes, which are smaller than the suffix after them
+            std::vector<bool> ls(n);
+            for(Index i = n - 2; i >= 0; --i)
+            {
+                ls[i] = (s[i] == s[i + 1]) ? ls[i + 1] : (s[i] < s[i + 1]);
+            }
+            //The start of the L part and of the S part of each character's bucket
+            std::vector<Index> sumL(upper + 1);
+            std::vector<Index> sumS(upper + 1);
+            for(Index i = 0; i < n; ++i)
+            {
+                if(!ls[i])
+                {
+                    ++sumS[s[i]];
+                }
+                else
+                {
+                    ++sumL[s[i] + 1];
+                }
+            }
+            for(Index i = 0; i <= upper; ++i)
+            {
+                sumS[i] += sumL[i];
+                if(i < upper)
+                {
+                    sumL[i + 1] += sumS[i];
+                }
+            }
+
+            std::vector<Index> bucket(upper + 1);
+            auto induce = [&](const std::vector<Index> & lms)
+            {
+                std::fill(sa.begin(), sa.end(), -1);
+                std::copy(sumS.begin(), sumS.end(), bucket.begin());
+                for(Index d : lms)
+                {
+                    if(d != n)
+                    {
+                        sa[bucket[s[d]]++] = d;
+                    }
+                }
+                std::copy(sumL.begin(), sumL.end(), bucket.begin());
+                sa[bucket[s[n - 1]]++] = n - 1;
+                for(Index i = 0; i < n; ++i)
+                {
+                    const Index v = sa[i];
+                    if((v >= 1) && !ls[v - 1])
+                    {
+                        sa[bucket[s[v - 1]]++] = v - 1;
+                    }
+                }
+                std::copy(sumL.begin(), sumL.end(), bucket.begin());
+                for(Index i = n - 1; i >= 0; --i)
+                {
+                    const Index v = sa[i];
+                    if((v >= 1) && ls[v - 1])
+                    {
+                        sa[--bucket[s[v - 1] + 1]] = v - 1;
+                    }
+                }
+            };
+
+            //LMS positions start an S run after an L suffix
+            std::vector<Index> lmsMap(n + 1, -1);
+            std::vector<Index> lms;
+            for(Index i = 1; i < n; ++i)
+            {
+                if(!ls[i - 1] && ls[i])
+                {
+                    lmsMap[i] = static_cast<Index>(lms.size());
+                    lms.push_back(i);
+                }
+            }
+            const Index m = static_cast<Index>(lms.size());
+
+            induce(lms);
+
+            if(m != 0)
+            {
+                std::vector<Index> sortedLms;
+                sortedLms.reserve(m);
+                for(Index v : sa)
+                {
+                    if(lmsMap[v] != -1)
+                    {
+                        sortedLms.push_back(v);
+                    }
+                }
+                //Rank the LMS substrings; equal substrings share a rank
+                std::vector<Index> reduced(m);
+                Index reducedUpper = 0;
+                reduced[lmsMap[sortedLms[0]]] = 0;
+                for(Index i = 1; i < m; ++i)
+                {
+                    Index l = sortedLms[i - 1];
+                    Index r = sortedLms[i];
+                    const Index endL = (lmsMap[l] + 1 < m) ? lms[lmsMap[l] + 1] : n;
+                    const Index endR = (lmsMap[r] + 1 < m) ? lms[lmsMap[r] + 1] : n;
+                    bool same = true;
+                    if(endL - l != endR - r)
+                    {
+                        same = false;
+                    }
+                    else
+                    {
+                        while((l < endL) && (s[l] == s[r]))
+                        {
+                            ++l;
+                            ++r;
+                        }
+                        if((l == n) || (s[l] != s[r]))
+                        {
+                            same = false;
+                        }
+                    }
+                    if(!same)
+                    {
+                        ++reducedUpper;
+                    }
+                    reduced[lmsMap[sortedLms[i]]] = reducedUpper;
+                }
+
+                const std::vector<Index> reducedSa = suffixArraySais(reduced, reducedUpper);
+                for(Index i = 0; i < m; ++i)
+                {
+                    sortedLms[i] = lms[reducedSa[i]];
+                }
+                induce(sortedLms);
+            }
+            return sa;
+        }
+    }
+
+
+    /**
+     * An index over a text for answering many substring queries: its suffix array, built in linear time with SA-IS,
+     * and the longest common prefix (LCP) of each pair of neighbouring suffixes, built with Kasai's algorithm.
+     * contains(), count() and findAll() binary search the sorted suffixes in O(m log n) for a pattern of length m,
+     * instead of scanning the text.
+     *
+     * Index is the signed integer type of the stored positions. The default 32-bit indices take 8 bytes per byte of
+     * text (suffix array and LCP); use std::int64_t for texts of 2 GB or more. The text must outlive the index.
+     *
+     * Throws std::invalid_argument if the text is too long for Index.
+     */
+    template<std::signed_integral Index = std::int32_t>
+    class SuffixArray
+    {
+    public:
+        explicit SuffixArray( std::string_view text )
+            : m_text(text)
+        {
+            if(text.size() >= static_cast<std::size_t>(std::numeric_limits<Index>::max()))
+            {
+                throw std::invalid_argument("SuffixArray(): the text is too long for this index type");
+            }
+            const std::vector<Index> symbols(reinterpret_cast<const unsigned char *>(text.data()),
+                                             reinterpret_cast<const unsigned char *>(text.data()) + text.size());
+            m_suffixes = detail::suffixArraySais(symbols, static_cast<Index>(255));
+            buildLcp();
+        }
+
+        std::string_view text() const
+        {
+            return m_text;
+        }
+
+        /**
+         * The start of each suffix of the text, in sorted order.
+         */
+        std::span<const Index> suffixes() const
+        {
+            return m_suffixes;
+        }
+
+        /**
+         * lcp()[i] is the length of the longest common prefix of the suffixes at suffixes()[i] and suffixes()[i + 1].
+         */
+        std::span<const Index> lcp() const
+        {
+            return m_lcp;
+        }
+
+        bool contains( std::string_view pattern ) const
+        {
+            const auto [first, last] = equalRange(pattern);
+            return first != last;
+        }
+
+        /**
+         * Returns the number of occurrences of pattern in the text, overlapping ones included.
+         */
+        std::size_t count( std::string_view pattern ) const
+        {
+            const auto [first, last] = equalRange(pattern);
+            return last - first;
+        }
+
+        /**
+         * Returns the positions of all occurrences of pattern in the text, in increasing order, like findAll().
+         */
+        std::vector<std::size_t> findAll( std::string_view pattern ) const
+        {
+            const auto [first, last] = equalRange(pattern);
+            std::vector<std::size_t> positions(m_suffixes.begin() + first, m_suffixes.begin() + last);
+            std::sort(positions.begin(), positions.end());
+            return positions;
+        }
+
+        /**
+         * Returns the longest substring that occurs at least twice in the text (the occurrences may overlap), or an
+         * empty view if no character repeats. It is the longest prefix shared by two neighbouring suffixes.
+         */
+        std::string_view longestRepeatedSubstring() const
+        {
+            const auto longest = std::max_element(m_lcp.begin(), m_lcp.end());
+            if((longest == m_lcp.end()) || (*longest == 0))
+            {
+                return m_text.substr(0, 0);
+            }
+            return m_text.substr(m_suffixes[longest - m_lcp.begin()], *longest);
+        }
+
+    private:
+        /**
+         * Returns the range of sorted suffixes starting with pattern, with two binary searches.
+         */
+        std::pair<std::size_t, std::size_t> equalRange( std::string_view pattern ) const
+        {
+            const auto prefixOf = [this, &pattern](Index suffix)
+            {
+                return m_text.substr(suffix, pattern.size());
+            };
+            const auto first = std::partition_point(m_suffixes.begin(), m_suffixes.end(), [&](Index suffix)
+            {
+                return prefixOf(suffix) < pattern;
+            });
+            const auto last = std::partition_point(first, m_suffixes.end(), [&](Index suffix)
+            {
+                return prefixOf(suffix) == pattern;
+            });
+            return {first - m_suffixes.begin(), last - m_suffixes.begin()};
+        }
+
+        /**
+         * Kasai's algorithm: going through the suffixes in text order, the LCP with the previous suffix in sorted
+         * order drops by at most one from one suffix to the next, so all of them are found in linear time.
+         */
+        void buildLcp()
+        {
+            const Index n = static_cast<Index>(m_text.size());
+            if(n == 0)
+            {
+                return;
+            }
+            std::vector<Index> rank(n);
+            for(Index i = 0; i < n; ++i)
+            {
+                rank[m_suffixes[i]] = i;
+            }
+            m_lcp.assign(n - 1, 0);
+            Index h = 0;
+            for(Index i = 0; i < n; ++i)
+            {
+                if(h > 0)
+                {
+                    --h;
+                }
+                if(rank[i] == 0)
+                {
+                    continue;
+                }
+                const Index j = m_suffixes[rank[i] - 1];
+                while((j + h < n) && (i + h < n) && (m_text[j + h] == m_text[i + h]))
+                {
+                    ++h;
+                }
+                m_lcp[rank[i] - 1] = h;
+            }
+        }
+
+        std::string_view m_text;
+        std::vector<Index> m_suffixes;
+        std::vector<Index> m_lcp;
+    };
+
+
+    namespace detail
+    {
+        /**
+         * A read-only bit vector with constant-time rank, over a flat array of 64-bit words: the bits, followed by two
+         * words for each block of 8 words (512 bits), the number of ones before the block and the 9-bit counts of ones
+         * before each of its words packed together. A rank is then one popcount; the directory costs 1/4 of the bits.
+         */
+        struct RankBitVector
+        {
+            const std::uint64_t * bits = nullptr;
+            const std::uint64_t * blockRanks = nullptr;
+
+            /**
+             * The number of words needed to store a bit vector of bitCount bits with its directory.
+             */
+            static std::size_t wordCount( std::size_t bitCount )
+            {
+                const std::size_t words = (bitCount + 63) / 64;
+                return words + 2 * (words / 8 + 1);
+            }
+
+            /**
+             * Writes the directory of the bits already stored at out, and returns the view of them.
+             */
+            static RankBitVector build(     std::uint64_t * out,
+                                            std::size_t bitCount    )
+            {
+                const std::size_t words = (bitCount + 63) / 64;
+                std::uint64_t * const ranks = out + words;
+                std::uint64_t ones = 0;
+                for(std::size_t block = 0; block <= words / 8; ++block)
+                {
+                    ranks[2 * block] = ones;
+                    std::uint64_t blockOnes = 0;
+                    std::uint64_t packed = 0;
+                    for(std::size_t w = 0; w < 8 && block * 8 + w < words; ++w)
+                    {
+                        if(w > 0)
+                        {
+                            packed |= blockOnes << (9 * (w - 1));
+                        }
+                        blockOnes += std::popcount(out[block * 8 + w]);
+                    }
+                    ranks[2 * block + 1] = packed;
+                    ones += blockOnes;
+                }
+                return view(out, bitCount);
+            }
+
+            static RankBitVector view(  const std::uint64_t * words,
+                                        std::size_t bitCount    )
+            {
+                return RankBitVector{words, words + (bitCount + 63) / 64};
+            }
+
+            bool get( std::uint64_t i ) const
+            {
+                return (bits[i / 64] >> (i % 64)) & 1;
+            }
+
+            /**
+             * The number of ones in the first i bits.
+             */
+            std::uint64_t rank1( std::uint64_t i ) const
+            {
+                const std::uint64_t word = i / 64;
+                const std::uint64_t block = word / 8;
+                const std::uint64_t inBlock = word % 8;
+                std::uint64_t ones = blockRanks[2 * block];
+                if(inBlock != 0)
+                {
+                    ones += (blockRanks[2 * block + 1] >> (9 * (inBlock - 1))) & 0x1FF;
+                }
+                if(i % 64 != 0)
+                {
+                    ones += std::popcount(bits[word] & ((std::uint64_t(1) << (i % 64)) - 1));
+                }
+                return ones;
+            }
+
+            std::uint64_t rank0( std::uint64_t i ) const
+            {
+                return i - rank1(i);
+            }
+        };
+    }
+
+
+    /**
+     * A succinct full-text index (FM-index): the Burrows-Wheeler transform of the text in a wavelet matrix, which
+     * answers rank queries on bytes, and a sample of the suffix array. It counts the occurrences of a pattern of length
+     * m in O(m) rank queries, and locates each one in at most sampleRate more steps.
+     *
+     * The index takes about 1.25 bytes per byte of text plus 8 / sampleRate for the samples, instead of the 8 of a
+     * SuffixArray, and it does not need the text once built. It can be saved to a file, and loaded back by mapping the
+     * file into memory, so opening even a very large index reads nothing up front.
+     *
+     * Building it takes the memory of a suffix array of the text. To index a file, build it from a MappedFile:
+     * FMIndex(MappedFile(path).view()).
+     *
+     * Throws std::invalid_argument if sampleRate is 0.
+     */
+    class FMIndex
+    {
+    public:
+        explicit FMIndex(   std::string_view text,
+                            std::size_t sampleRate = 32     )
+        {
+            if(sampleRate == 0)
+            {
+                throw std::invalid_argument("FMIndex(): the sample rate cannot be 0");
+            }
+            if(text.size() + 1 < static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max()))
+            {
+                build<std::int32_t>(text, sampleRate);
+            }
+            else
+            {
+                build<std::int64_t>(text, sampleRate);
+            }
+            attach();
+        }
+
+        FMIndex( const FMIndex & ) = delete;
+        FMIndex & operator=( const FMIndex & ) = delete;
+
+        FMIndex( FMIndex && other ) noexcept
+            : m_owned(std::move(other.m_owned)),
+              m_file(std::move(other.m_file))
+        {
+            attach();
+        }
+
+        FMIndex & operator=( FMIndex && other ) noexcept
+        {
+            m_owned = std::move(other.m_owned);
+            m_file = std::move(other.m_file);
+            attach();
+            return *this;
+        }
+
+        /**
+         * Loads an index saved with save(), by mapping the file into memory.
+         *
+         * Throws std::invalid_argument if the file cannot be opened or does not hold an index.
+         */
+        static FMIndex load( const std::string & filePath )
+        {
+            return FMIndex(MappedFile(filePath), filePath);
+        }
+
+        /**
+         * Saves the index to a file, in the byte order of this machine.
+         *
+         * Throws std::invalid_argument if the file cannot be written.
+         */
+        void save( const std::string & filePath ) const
+        {
+            std::ofstream output_file(filePath, std::ios::binary);
+            if(!output_file.is_open())
+            {
+                throw std::invalid_argument("Error, could not write file: " + filePath);
+            }
+            output_file.write(reinterpret_cast<const char *>(m_words), m_words[header::totalWords] * sizeof(std::uint64_t));
+            if(!output_file)
+            {
+                throw std::invalid_argument("Error, could not write file: " + filePath);
+            }
+        }
+
+        /**
+         * The length of the indexed text.
+         */
+        std::size_t size() const
+        {
+            return m_textLength;
+        }
+
+        bool contains( std::string_view pattern ) const
+        {
+            return count(pattern) != 0;
+        }
+
+        /**
+         * Returns the number of occurrences of pattern in the text, overlapping ones included.
+         */
+        std::size_t count( std::string_view pattern ) const
+        {
+            const auto [first, last] = backwardSearch(pattern);
+            return last - first;
+        }
+
+        /**
+         * Returns the positions of all occurrences of pattern in the text, in increasing order, like findAll().
+         */
+        std::vector<std::size_t> locate( std::string_view pattern ) const
+        {
+            const auto [first, last] = backwardSearch(pattern);
+            std::vector<std::size_t> positions;
+            positions.reserve(last - first);
+            for(std::uint64_t i = first; i < last; ++i)
+            {
+                //Walk back through the text until a sampled suffix is reached
+                std::uint64_t row = i;
+                std::uint64_t steps = 0;
+                while(!m_sampled.get(row))
+                {
+                    row = lastToFirst(row);
+                    ++steps;
+                }
+                positions.push_back(m_samples[m_sampled.rank1(row)] + steps);
+            }
+            std::sort(positions.begin(), positions.end());
+            return positions;
+        }
+
+    private:
+        //The positions of the header fields, in words
+        struct header
+        {
+            static constexpr std::size_t magic = 0;
+            static constexpr std::size_t version = 1;
+            static constexpr std::size_t textLength = 2;
+            static constexpr std::size_t sentinelRow = 3;
+            static constexpr std::size_t sampleRate = 4;
+            static constexpr std::size_t sampleCount = 5;
+            static constexpr std::size_t totalWords = 6;
+            static constexpr std::size_t size = 7;
+        };
+        //"SSLFMIDX" as a number, which also tells apart files saved with another byte order
+        static constexpr std::uint64_t magicNumber = 0x5853444D464C5353ULL;
+        static constexpr std::uint64_t formatVersion = 1;
+        static constexpr std::size_t levels = 8;
+
+        FMIndex(    MappedFile file,
+                    const std::string & filePath    )
+            : m_file(std::move(file))
+        {
+            const std::string_view data = m_file->view();
+            const auto words = reinterpret_cast<const std::uint64_t *>(data.data());
+            const bool valid = (data.size() >= header::size * sizeof(std::uint64_t))
+                && (words[header::magic] == magicNumber) && (words[header::version] == formatVersion)
+                && (words[header::totalWords] * sizeof(std::uint64_t) == data.size())
+                && (words[header::totalWords] == layoutWords(words[header::textLength], words[header::sampleCount]));
+            if(!valid)
+            {
+                throw std::invalid_argument("Error, not an FM-index file: " + filePath);
+            }
+            attach();
+        }
+
+        /**
+         * The number of words of an index, laid out as: the header, the 257 counts C, the number of zeros of each
+         * wavelet matrix level, the levels' bit vectors, the bit vector of sampled rows, and the samples.
+         */
+        static std::size_t layoutWords(     std::size_t textLength,
+                                            std::size_t sampleCount     )
+        {
+            const std::size_t rowBits = detail::RankBitVector::wordCount(textLength + 1);
+            return header::size + 257 + levels + (levels + 1) * rowBits + sampleCount;
+        }
+
+        /**
+         * Builds the index into m_owned. The text is shifted up by one so that a 0 sentinel, smaller than every byte,
+         * ends it; the suffix array of that gives the BWT, whose row holding the sentinel is stored apart.
+         */
+        template<typename Index>
+        void build(     std::string_view text,
+                        std::size_t sampleRate  )
+        {
+            const std::size_t rows = text.size() + 1;
+            std::vector<Index> suffixes;
+            {
+                std::vector<Index> symbols(rows);
+                for(std::size_t i = 0; i < text.size(); ++i)
+                {
+                    symbols[i] = static_cast<Index>(static_cast<unsigned char>(text[i])) + 1;
+                }
+                symbols[text.size()] = 0;
+                suffixes = detail::suffixArraySais(symbols, static_cast<Index>(256));
+            }
+
+            std::size_t sampleCount = 0;
+            for(Index suffix : suffixes)
+            {
+                sampleCount += (static_cast<std::size_t>(suffix) % sampleRate == 0);
+            }
+            m_owned.assign(layoutWords(text.size(), sampleCount), 0);
+            std::uint64_t * const words = m_owned.data();
+            words[header::magic] = magicNumber;
+            words[header::version] = formatVersion;
+            words[header::textLength] = text.size();
+            words[header::sampleRate] = sampleRate;
+            words[header::sampleCount] = sampleCount;
+            words[header::totalWords] = m_owned.size();
+
+            //The BWT, with the sentinel stored as a 0 byte, and C[c], the number of symbols smaller than c
+            std::vector<unsigned char> bwt(rows);
+            std::uint64_t * const counts = words + header::size;
+            for(std::size_t row = 0; row < rows; ++row)
+            {
+                if(suffixes[row] == 0)
+                {
+                    words[header::sentinelRow] = row;
+                    bwt[row] = 0;
+                }
+                else
+                {
+                    bwt[row] = static_cast<unsigned char>(text[suffixes[row] - 1]);
+                    ++counts[bwt[row] + 1];
+                }
+            }
+            counts[0] = 1;
+            for(std::size_t c = 1; c <= 256; ++c)
+            {
+                counts[c] += counts[c - 1];
+            }
+
+            //Wavelet matrix: level l holds bit 7 - l of each symbol, and then stably moves the zeros before the ones
+            std::uint64_t * const zeros = counts + 257;
+            std::uint64_t * level = zeros + levels;
+            const std::size_t rowBits = detail::RankBitVector::wordCount(rows);
+            std::vector<unsigned char> next(rows);
+            for(std::size_t l = 0; l < levels; ++l, level += rowBits)
+            {
+                const unsigned shift = 7 - l;
+                std::size_t zeroCount = 0;
+                for(std::size_t row = 0; row < rows; ++row)
+                {
+                    if((bwt[row] >> shift) & 1)
+                    {
+                        level[row / 64] |= std::uint64_t(1) << (row % 64);
+                    }
+                    else
+                    {
+                        ++zeroCount;
+                    }
+                }
+                zeros[l] = zeroCount;
+                detail::RankBitVector::build(level, rows);
+                std::size_t zero = 0;
+                std::size_t one = zeroCount;
+                for(std::size_t row = 0; row < rows; ++row)
+                {
+                    next[((bwt[row] >> shift) & 1) ? one++ : zero++] = bwt[row];
+                }
+                bwt.swap(next);
+            }
+
+            //The rows whose suffix starts at a multiple of the sample rate, and those positions in row order
+            std::uint64_t * const sampled = level;
+            std::uint64_t * sample = sampled + rowBits;
+            for(std::size_t row = 0; row < rows; ++row)
+            {
+                if(static_cast<std::size_t>(suffixes[row]) % sampleRate == 0)
+                {
+                    sampled[row / 64] |= std::uint64_t(1) << (row % 64);
+                    *sample++ = suffixes[row];
+                }
+            }
+            detail::RankBitVector::build(sampled, rows);
+        }
+
+        /**
+         * Points the views at the words of the index, owned or mapped.
+         */
+        void attach()
+        {
+            m_words = m_file ? reinterpret_cast<const std::uint64_t *>(m_file->view().data()) : m_owned.data();
+            m_textLength = m_words[header::textLength];
+            m_sentinelRow = m_words[header::sentinelRow];
+            m_counts = m_words + header::size;
+            m_zeros = m_counts + 257;
+            const std::size_t rows = m_textLength + 1;
+            const std::size_t rowBits = detail::RankBitVector::wordCount(rows);
+            const std::uint64_t * level = m_zeros + levels;
+            for(std::size_t l = 0; l < levels; ++l, level += rowBits)
+            {
+                m_levels[l] = detail::RankBitVector::view(level, rows);
+            }
+            m_sampled = detail::RankBitVector::view(level, rows);
+            m_samples = level + rowBits;
+        }
+
+        /**
+         * The number of occurrences of byte c in the first i rows of the BWT, not counting the sentinel.
+         */
+        std::uint64_t rank(     unsigned char c,
+                                std::uint64_t i     ) const
+        {
+            const bool afterSentinel = (c == 0) && (m_sentinelRow < i);
+            std::uint64_t begin = 0;
+            for(std::size_t l = 0; l < levels; ++l)
+            {
+                if((c >> (7 - l)) & 1)
+                {
+                    begin = m_zeros[l] + m_levels[l].rank1(begin);
+                    i = m_zeros[l] + m_levels[l].rank1(i);
+                }
+                else
+                {
+                    begin = m_levels[l].rank0(begin);
+                    i = m_levels[l].rank0(i);
+                }
+            }
+            return i - begin - afterSentinel;
+        }
+
+        /**
+         * The byte of the BWT at a row.
+         */
+        unsigned char access( std::uint64_t row ) const
+        {
+            unsigned c = 0;
+            for(std::size_t l = 0; l < levels; ++l)
+            {
+                const bool bit = m_levels[l].get(row);
+                c = (c << 1) | bit;
+                row = bit ? m_zeros[l] + m_levels[l].rank1(row) : m_levels[l].rank0(row);
+            }
+            return static_cast<unsigned char>(c);
+        }
+
+        /**
+         * The row of the suffix starting one character before the suffix of a row (LF mapping).
+         */
+        std::uint64_t lastToFirst( std::uint64_t row ) const
+        {
+            const unsigned char c = access(row);
+            return m_counts[c] + rank(c, row);
+        }
+
+        /**
+         * Returns the range of rows whose suffix starts with pattern, extending the match one character leftwards at a
+         * time.
+         */
+        std::pair<std::uint64_t, std::uint64_t> backwardSearch( std::string_view pattern ) const
+        {
+            std::uint64_t first = 0;
+            std::uint64_t last = m_textLength + 1;
+            for(std::size_t i = pattern.size(); (i-- > 0) && (first < last);)
+            {
+                const unsigned char c = static_cast<unsigned char>(pattern[i]);
+                first = m_counts[c] + rank(c, first);
+                last = m_counts[c] + rank(c, last);
+            }
+            return {first, std::max(first, last)};
+        }
+
+        std::vector<std::uint64_t> m_owned;
+        std::optional<MappedFile> m_file;
+
+        const std::uint64_t * m_words = nullptr;
+        std::uint64_t m_textLength = 0;
+        std::uint64_t m_sentinelRow = 0;
+        const std::uint64_t * m_counts = nullptr;
+        const std::uint64_t * m_zeros = nullptr;
+        detail::RankBitVector m_levels[levels];
+        detail::RankBitVector m_sampled;
+        const std::uint64_t * m_samples = nullptr;
+    };
+
+
+    namespace detail
+    {
+        /**
+         * A pattern prepared for Myers' bit-parallel edit distance: for every byte, the bits of the positions where it
+         * occurs in the pattern, split into blocks of 64 positions.
+         */
+        class MyersPattern
+        {
+        public:
+            explicit MyersPattern( std::string_view pattern )
+                : m_length(pattern.size()),
+                  m_blocks((pattern.size() + 63) / 64),
+                  m_masks(256 * m_blocks, 0)
+            {
+                for(std::size_t i = 0; i < pattern.size(); ++i)
+                {
+                    m_masks[static_cast<unsigned char>(pattern[i]) * m_blocks + i / 64] |= std::uint64_t(1) << (i % 64);
+                }
+            }
+
+            std::size_t length() const
+            {
+                return m_length;
+            }
+
+            std::size_t blocks() const
+            {
+                return m_blocks;
+            }
+
+            /**
+             * The masks of byte c, one per block.
+             */
+            const std::uint64_t * masks( unsigned char c ) const
+            {
+                return m_masks.data() + c * m_blocks;
+            }
+
+            /**
+             * The number of pattern positions in a block: 64, except maybe in the last one.
+             */
+            std::size_t blockHeight( std::size_t block ) const
+            {
+                return (block + 1 < m_blocks) ? 64 : m_length - 64 * block;
+            }
+
+        private:
+            std::size_t m_length;
+            std::size_t m_blocks;
+            std::vector<std::uint64_t> m_masks;
+        };
+
+        /**
+         * Advances one block of a column of the edit distance matrix by one text character (Myers 1999). pv and mv are
+         * the block's positive and negative vertical deltas, eq its mask for the character, and horizontalIn the
+         * difference (-1, 0 or +1) carried into its top row. Returns the difference at the row of highBit.
+         */
+        inline int myersAdvanceBlock(   std::uint64_t & pv,
+                                        std::uint64_t & mv,
+                                        std::uint64_t eq,
+                                        int horizontalIn,
+                                        std::uint64_t highBit   )
+        {
+            const std::uint64_t xv = eq | mv;
+            if(horizontalIn < 0)
+            {
+                eq |= 1;
+            }
+            const std::uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+            std::uint64_t ph = mv | ~(xh | pv);
+            std::uint64_t mh = pv & xh;
+            const int horizontalOut = ((ph & highBit) != 0) - ((mh & highBit) != 0);
+            ph <<= 1;
+            mh <<= 1;
+            if(horizontalIn < 0)
+            {
+                mh |= 1;
+            }
+            else if(horizontalIn > 0)
+            {
+                ph |= 1;
+            }
+            pv = mh | ~(xv | ph);
+            mv = ph & xv;
+            return horizontalOut;
+        }
+
+        /**
+         * Runs Myers' algorithm over text and calls callback(offset + end, distance) for every end, from firstEnd on, of
+         * a substring within maxDistance edits of the pattern, with the smallest such distance. Returns false if the
+         * callback returned false to stop. Patterns of up to 64 characters take one word per text character; longer
+         * ones only compute the blocks that can still be within maxDistance (Ukkonen's cut-off).
+         */
+        template<typename Callback>
+        bool scanApproximateEnds(   std::string_view text,
+                                    const MyersPattern & pattern,
+                                    std::size_t maxDistance,
+                                    std::size_t firstEnd,
+                                    std::size_t offset,
+                                    Callback && callback    )
+        {
+            const std::size_t m = pattern.length();
+            //The empty substring at the start is m deletions away
+            if((firstEnd == 0) && (m <= maxDistance) && !callback(offset, m))
+            {
+                return false;
+            }
+            if(pattern.blocks() == 1)
+            {
+                const std::uint64_t highBit = std::uint64_t(1) << (m - 1);
+                std::uint64_t pv = ~std::uint64_t(0);
+                std::uint64_t mv = 0;
+                std::size_t score = m;
+                for(std::size_t j = 0; j < text.size(); ++j)
+                {
+                    score += myersAdvanceBlock(pv, mv, *pattern.masks(static_cast<unsigned char>(text[j])), 0, highBit);
+                    if((score <= maxDistance) && (j + 1 >= firstEnd) && !callback(offset + j + 1, score))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            const std::size_t lastBlock = pattern.blocks() - 1;
+            std::vector<std::uint64_t> pv(pattern.blocks(), ~std::uint64_t(0));
+            std::vector<std::uint64_t> mv(pattern.blocks(), 0);
+            std::vector<std::size_t> score(pattern.blocks());
+            for(std::size_t b = 0; b <= lastBlock; ++b)
+            {
+                score[b] = 64 * b + pattern.blockHeight(b);
+            }
+            const auto highBit = [&](std::size_t b) { return std::uint64_t(1) << (pattern.blockHeight(b) - 1); };
+            //The last block that can hold a value within maxDistance
+            std::size_t active = std::min(lastBlock, maxDistance / 64);
+            for(std::size_t j = 0; j < text.size(); ++j)
+            {
+                const std::uint64_t * const eq = pattern.masks(static_cast<unsigned char>(text[j]));
+                int carry = 0;
+                for(std::size_t b = 0; b <= active; ++b)
+                {
+                    carry = myersAdvanceBlock(pv[b], mv[b], eq[b], carry, highBit(b));
+                    score[b] += carry;
+                }
+                if((active < lastBlock) && (score[active] - carry <= maxDistance) && ((eq[active + 1] & 1) || (carry < 0)))
+                {
+                    //The next block can now get within maxDistance: start it as if all its rows were one more than the last
+                    ++active;
+                    pv[active] = ~std::uint64_t(0);
+                    mv[active] = 0;
+                    score[active] = score[active - 1] - carry + pattern.blockHeight(active)
+                                  + myersAdvanceBlock(pv[active], mv[active], eq[active], carry, highBit(active));
+                }
+                else
+                {
+                    while((active > 0) && (score[active] >= maxDistance + pattern.blockHeight(active)))
+                    {
+                        --active;
+                    }
+                }
+                if((active == lastBlock) && (score[lastBlock] <= maxDistance) && (j + 1 >= firstEnd)
+                    && !callback(offset + j + 1, score[lastBlock]))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * Calls callback(end, distance) for every end position in text of a substring within maxDistance edits of the
+         * pattern, with the smallest such distance, until the callback returns false.
+         *
+         * A match within maxDistance edits contains one of maxDistance + 1 pieces of the pattern unchanged (pigeonhole
+         * principle), so when the pieces are long enough they are searched for exactly, with std::string_view::find(),
+         * and Myers' algorithm only runs around them: from m + maxDistance characters before the first end such a match
+         * can have. Where the pieces are too frequent for this to pay off, it scans the whole text.
+         */
+        template<typename Callback>
+        void forEachApproximateEnd(     std::string_view text,
+                                        std::string_view patternText,
+                                        const MyersPattern & pattern,
+                                        std::size_t maxDistance,
+                                        Callback && callback    )
+        {
+            const std::size_t m = pattern.length();
+            if(m == 0)
+            {
+                for(std::size_t end = 0; end <= text.size(); ++end)
+                {
+                    if(!callback(end, std::size_t(0)))
+                    {
+                        return;
+                    }
+                }
+                return;
+            }
+
+            const std::size_t pieces = maxDistance + 1;
+            const std::size_t reach = m + maxDistance;
+            if((m / pieces < 3) || (text.size() < 4 * reach))
+            {
+                scanApproximateEnds(text, pattern, maxDistance, 0, 0, callback);
+                return;
+            }
+
+            //The ranges of ends a match can have around each occurrence of a piece: a match containing the piece at p
+            //ends at least at its end, and at most at p + m + maxDistance
+            std::vector<std::pair<std::size_t, std::size_t>> ends;
+            std::size_t scanned = 0;
+            for(std::size_t piece = 0; piece < pieces; ++piece)
+            {
+                const std::string_view pieceText = patternText.substr(piece * m / pieces, (piece + 1) * m / pieces - piece * m / pieces);
+                for(std::size_t p = text.find(pieceText); p != std::string_view::npos; p = text.find(pieceText, p + 1))
+                {
+                    ends.emplace_back(p + pieceText.size(), std::min(text.size(), p + reach));
+                    scanned += 2 * reach;
+                    if(scanned > text.size() / 2)
+                    {
+                        scanApproximateEnds(text, pattern, maxDistance, 0, 0, callback);
+                        return;
+                    }
+                }
+            }
+            std::sort(ends.begin(), ends.end());
+
+            for(std::size_t i = 0; i < ends.size();)
+            {
+                const std::size_t firstEnd = ends[i].first;
+                std::size_t lastEnd = ends[i].second;
+                for(++i; (i < ends.size()) && (ends[i].first <= lastEnd + 1); ++i)
+                {
+                    lastEnd = std::max(lastEnd, ends[i].second);
+                }
+                const std::size_t begin = (firstEnd > reach) ? firstEnd - reach : 0;
+                if(!scanApproximateEnds(text.substr(begin, lastEnd - begin), pattern, maxDistance, firstEnd - begin, begin, callback))
+                {
+                    return;
+                }
+            }
+        }
+    }
+
+
+    /**
+     * A substring of a text approximately matching a pattern: its end, one past its last character, and its edit
+     * distance (Levenshtein) to the pattern.
+     */
+    struct ApproximateMatch
+    {
+        std::size_t end;
+        std::size_t distance;
+
+        bool operator==( const ApproximateMatch & ) const = default;
+    };
+
+
+    /**
+     * Finds the substrings of a string within a number of edits (insertions, deletions or substitutions) of a pattern,
+     * like findAll() with typos allowed. Since a match can always be stretched or shrunk by an edit, matches are
+     * reported by where they end: every end position with the smallest distance of a substring ending there.
+     *
+     * Runs in O(n) for patterns of up to 64 characters, with Myers' bit-parallel algorithm, and in O(n * k / 64) for
+     * longer ones, independent of the alphabet. When the pattern is long compared to maxDistance, exact searches for
+     * pieces of it skip most of the text.
+     *
+     * @param str - The string to search.
+     * @param pattern - The pattern to look for.
+     * @param maxDistance - The largest number of edits allowed.
+     *
+     * @retval std::vector<ApproximateMatch> - The matches, by increasing end.
+     */
+    std::vector<ApproximateMatch> findApproximate(  std::string_view str,
+                                                    std::string_view pattern,
+                                                    std::size_t maxDistance     )
+    {
+        std::vector<ApproximateMatch> matches;
+        detail::forEachApproximateEnd(str, pattern, detail::MyersPattern(pattern), maxDistance, [&](std::size_t end, std::size_t distance)
+        {
+            matches.push_back({end, distance});
+            return true;
+        });
+        return matches;
+    }
+
+
+    /**
+     * Checks if a string contains a substring within a number of edits of a pattern, stopping at the first one.
+     *
+     * @param str - The string to search.
+     * @param pattern - The pattern to look for.
+     * @param maxDistance - The largest number of edits allowed.
+     *
+     * @retval bool - True if a substring of str is within maxDistance edits of pattern.
+     */
+    bool containsApproximate(   std::string_view str,
+                                std::string_view pattern,
+                                std::size_t maxDistance     )
+    {
+        bool found = false;
+        detail::forEachApproximateEnd(str, pattern, detail::MyersPattern(pattern), maxDistance, [&](std::size_t, std::size_t)
+        {
+            found = true;
+            return false;
+        });
+        return found;
+    }
+
+
+    /**
+     * Finds the substring of a string closest to a pattern in edit distance, stopping early at an exact match.
+     *
+     * @param str - The string to search.
+     * @param pattern - The pattern to look for.
+     *
+     * @retval ApproximateMatch - The first end of a substring with the smallest edit distance to pattern. If none is
+     *                            closer than deleting the whole pattern, the end is 0 and the distance the pattern's
+     *                            length.
+     */
+    ApproximateMatch bestApproximateMatch(  std::string_view str,
+                                            std::string_view pattern    )
+    {
+        ApproximateMatch best{0, pattern.size()};
+        detail::forEachApproximateEnd(str, pattern, detail::MyersPattern(pattern), pattern.size(), [&](std::size_t end, std::size_t distance)
+        {
+            if(distance < best.distance)
+            {
+                best = {end, distance};
+            }
+            return best.distance != 0;
+        });
+        return best;
+    }
+
+
+    namespace detail
+    {
+        /**
+         * The Levenshtein distance between text and a pattern, with Myers' algorithm: the pattern's column of the edit
+         * distance matrix is advanced one text character at a time, 64 rows per word. Returns maxDistance + 1 as soon
+         * as the distance is known to be larger, i.e. when the last row, which can drop by at most one per remaining
+         * character, cannot come back within it.
+         */
+        inline std::size_t myersGlobalDistance(     std::string_view text,
+                                                    const MyersPattern & pattern,
+                                                    std::size_t maxDistance     )
+        {
+            const std::size_t m = pattern.length();
+            const std::size_t n = text.size();
+            if(((m > n) ? m - n : n - m) > maxDistance)
+            {
+                return maxDistance + 1;
+            }
+            if(m == 0)
+            {
+                return n;
+            }
+
+            std::size_t score = m;
+            if(pattern.blocks() == 1)
+            {
+                const std::uint64_t highBit = std::uint64_t(1) << (m - 1);
+                std::uint64_t pv = ~std::uint64_t(0);
+                std::uint64_t mv = 0;
+                for(std::size_t j = 0; j < n; ++j)
+                {
+                    score += myersAdvanceBlock(pv, mv, *pattern.masks(static_cast<unsigned char>(text[j])), 1, highBit);
+                    if((score > maxDistance) && (score - maxDistance > n - j - 1))
+                    {
+                        return maxDistance + 1;
+                    }
+                }
+                return score;
+            }
+
+            std::vector<std::uint64_t> pv(pattern.blocks(), ~std::uint64_t(0));
+            std::vector<std::uint64_t> mv(pattern.blocks(), 0);
+            for(std::size_t j = 0; j < n; ++j)
+            {
+                const std::uint64_t * const eq = pattern.masks(static_cast<unsigned char>(text[j]));
+                //The first row of the matrix is 0, 1, 2, ...: it carries +1 into the top block
+                int carry = 1;
+                for(std::size_t b = 0; b < pattern.blocks(); ++b)
+                {
+                    carry = myersAdvanceBlock(pv[b], mv[b], eq[b], carry, std::uint64_t(1) << (pattern.blockHeight(b) - 1));
+                }
+                score += carry;
+                if((score > maxDistance) && (score - maxDistance > n - j - 1))
+                {
+                    return maxDistance + 1;
+                }
+            }
+            return score;
+        }
+    }
+
+
+    /**
+     * Computes the Levenshtein distance between two strings: the smallest number of single character insertions,
+     * deletions and substitutions turning one into the other. Uses Myers' bit-parallel algorithm over the shorter
+     * string, in O(n * m / 64) time and O(min(n, m)) memory.
+     *
+     * @param str1 - The first string.
+     * @param str2 - The second string.
+     * @param maxDistance - The largest distance of interest. The computation stops as soon as the distance is known to
+     *                      be larger, and then returns maxDistance + 1.
+     *
+     * @retval std::size_t - The distance, or maxDistance + 1 if it is larger than maxDistance.
+     */
+    std::size_t levenshteinDistance(    std::string_view str1,
+                                        std::string_view str2,
+                                        std::size_t maxDistance = std::numeric_limits<std::size_t>::max() - 1    )
+    {
+        if(str1.size() > str2.size())
+        {
+            std::swap(str1, str2);
+        }
+        return detail::myersGlobalDistance(str2, detail::MyersPattern(str1), maxDistance);
+    }
+
+
+    /**
+     * Computes the Damerau-Levenshtein distance between two strings, in its optimal string alignment form: like
+     * levenshteinDistance(), but swapping two adjacent characters also counts as one edit, provided no substring is
+     * edited more than once. Takes O(n * m) time and O(min(n, m)) memory.
+     *
+     * @param str1 - The first string.
+     * @param str2 - The second string.
+     * @param maxDistance - The largest distance of interest. The computation stops once two consecutive rows of the
+     *                      matrix are all above it, and then returns maxDistance + 1.
+     *
+     * @retval std::size_t - The distance, or maxDistance + 1 if it is larger than maxDistance.
+     */
+    std::size_t damerauLevenshteinDistance(     std::string_view str1,
+                                                std::string_view str2,
+                                                std::size_t maxDistance = std::numeric_limits<std::size_t>::max() - 1    )
+    {
+        if(str1.size() > str2.size())
+        {
+            std::swap(str1, str2);
+        }
+        const std::size_t m = str1.size();
+        if(str2.size() - m > maxDistance)
+        {
+            return maxDistance + 1;
+        }
+
+        //The last three rows of the matrix, over the shorter string
+        std::vector<std::size_t> rows(3 * (m + 1));
+        std::size_t * previousPrevious = rows.data();
+        std::size_t * previous = previousPrevious + m + 1;
+        std::size_t * current = previous + m + 1;
+        for(std::size_t j = 0; j <= m; ++j)
+        {
+            previous[j] = j;
+        }
+        std::size_t previousMinimum = 0;
+        for(std::size_t i = 1; i <= str2.size(); ++i)
+        {
+            current[0] = i;
+            std::size_t minimum = i;
+            for(std::size_t j = 1; j <= m; ++j)
+            {
+                std::size_t distance = std::min({previous[j] + 1, current[j - 1] + 1, previous[j - 1] + (str1[j - 1] != str2[i - 1])});
+                if((i > 1) && (j > 1) && (str1[j - 1] == str2[i - 2]) && (str1[j - 2] == str2[i - 1]))
+                {
+                    distance = std::min(distance, previousPrevious[j - 2] + 1);
+                }
+                current[j] = distance;
+                minimum = std::min(minimum, distance);
+            }
+            //A transposition can skip a row, but not two
+            if(std::min(minimum, previousMinimum) > maxDistance)
+            {
+                return maxDistance + 1;
+            }
+            previousMinimum = minimum;
+            std::size_t * const oldest = previousPrevious;
+            previousPrevious = previous;
+            previous = current;
+            current = oldest;
+        }
+        return std::min(previous[m], maxDistance + 1);
+    }
+
+
+    namespace detail
+    {
+        /**
+         * The Jaro similarity of two non-empty strings, with zeroed flags for their matched characters.
+         */
+        inline double jaroSimilarity(   std::string_view str1,
+                                        std::string_view str2,
+                                        char * matched1,
+                                        char * matched2     )
+        {
+            const std::size_t window = std::max(str1.size(), str2.size()) / 2;
+            const std::size_t reach = (window > 0) ? window - 1 : 0;
+            std::size_t matches = 0;
+            for(std::size_t i = 0; i < str1.size(); ++i)
+            {
+                const std::size_t first = (i > reach) ? i - reach : 0;
+                const std::size_t last = std::min(str2.size(), i + reach + 1);
+                for(std::size_t j = first; j < last; ++j)
+                {
+                    if(!matched2[j] && (str1[i] == str2[j]))
+                    {
+                        matched1[i] = 1;
+                        matched2[j] = 1;
+                        ++matches;
+                        break;
+                    }
+                }
+            }
+            if(matches == 0)
+            {
+                return 0.0;
+            }
+
+            //Half the number of matched characters out of order
+            std::size_t outOfOrder = 0;
+            for(std::size_t i = 0, j = 0; i < str1.size(); ++i)
+            {
+                if(matched1[i])
+                {
+                    while(!matched2[j])
+                    {
+                        ++j;
+                    }
+                    outOfOrder += (str1[i] != str2[j]);
+                    ++j;
+                }
+            }
+            const double m = static_cast<double>(matches);
+            return (m / str1.size() + m / str2.size() + (m - outOfOrder / 2.0) / m) / 3.0;
+        }
+    }
+
+
+    /**
+     * Computes the Jaro similarity of two strings: characters are matched when equal and at most
+     * max(n, m) / 2 - 1 positions apart, and the similarity combines the fraction of matched characters in each string
+     * with the fraction of matches in the same order.
+     *
+     * @param str1 - The first string.
+     * @param str2 - The second string.
+     *
+     * @retval double - The similarity, from 0 (nothing in common) to 1 (equal strings).
+     */
+    double jaroSimilarity(  std::string_view str1,
+                            std::string_view str2   )
+    {
+        if(str1.empty() && str2.empty())
+        {
+            return 1.0;
+        }
+        if(str1.empty() || str2.empty())
+        {
+            return 0.0;
+        }
+        //Words and names fit the flags on the stack
+        if(std::max(str1.size(), str2.size()) <= 64)
+        {
+            std::array<char, 64> matched1{};
+            std::array<char, 64> matched2{};
+            return detail::jaroSimilarity(str1, str2, matched1.data(), matched2.data());
+        }
+        std::vector<char> matched1(str1.size(), 0);
+        std::vector<char> matched2(str2.size(), 0);
+        return detail::jaroSimilarity(str1, str2, matched1.data(), matched2.data());
+    }
+
+
+    /**
+     * Computes the Jaro-Winkler similarity of two strings: the Jaro similarity, raised for strings sharing a prefix of
+     * up to 4 characters, which suits names and other short strings where typos are rarer at the start.
+     *
+     * Throws std::invalid_argument if prefixScale is not between 0 and 0.25.
+     *
+     * @param str1 - The first string.
+     * @param str2 - The second string.
+     * @param prefixScale - How much each common prefix character counts, 0.1 being the usual value.
+     *
+     * @retval double - The similarity, from 0 (nothing in common) to 1 (equal strings).
+     */
+    double jaroWinklerSimilarity(   std::string_view str1,
+                                    std::string_view str2,
+                                    double prefixScale = 0.1    )
+    {
+        if(!(prefixScale >= 0.0 && prefixScale <= 0.25))
+        {
+            throw std::invalid_argument("jaroWinklerSimilarity(): prefixScale must be between 0 and 0.25");
+        }
+        const double jaro = jaroSimilarity(str1, str2);
+        std::size_t prefix = 0;
+        while((prefix < 4) && (prefix < str1.size()) && (prefix < str2.size()) && (str1[prefix] == str2[prefix]))
+        {
+            ++prefix;
+        }
+        return jaro + prefix * prefixScale * (1.0 - jaro);
+    }
+
+
+    /**
+     * Computes the length of the longest common subsequence of two strings: the most characters that can be kept from
+     * both, in order, by deleting the others. Uses the bit-parallel algorithm of Allison, Dix and Hyyro over the
+     * shorter string, in O(n * m / 64) time.
+     *
+     * @param str1 - The first string.
+     * @param str2 - The second string.
+     *
+     * @retval std::size_t - The length of the longest common subsequence.
+     */
+    std::size_t longestCommonSubsequenceLength(     std::string_view str1,
+                                                    std::string_view str2   )
+    {
+        if(str1.size() > str2.size())
+        {
+            std::swap(str1, str2);
+        }
+        if(str1.empty())
+        {
+            return 0;
+        }
+        const detail::MyersPattern pattern(str1);
+        //The zeros of v mark the rows where the LCS so far grows by one
+        std::vector<std::uint64_t> v(pattern.blocks(), ~std::uint64_t(0));
+        for(char c : str2)
+        {
+            const std::uint64_t * const eq = pattern.masks(static_cast<unsigned char>(c));
+            std::uint64_t carry = 0;
+            for(std::size_t b = 0; b < v.size(); ++b)
+            {
+                const std::uint64_t u = v[b] & eq[b];
+                const std::uint64_t sum = v[b] + u;
+                const std::uint64_t total = sum + carry;
+                carry = (sum < v[b]) | (total < sum);
+                v[b] = total | (v[b] - u);
+            }
+        }
+        std::size_t length = 0;
+        for(std::size_t b = 0; b < v.size(); ++b)
+        {
+            const std::size_t height = pattern.blockHeight(b);
+            const std::uint64_t valid = (height == 64) ? ~std::uint64_t(0) : (std::uint64_t(1) << height) - 1;
+            length += std::popcount(~v[b] & valid);
+        }
+        return length;
+    }
+
+
+    /**
+     * Compares one query string against many others by Levenshtein distance, preparing the query once: the record
+     * linkage and deduplication case.
+     */
+    class LevenshteinMatcher
+    {
+    public:
+        explicit LevenshteinMatcher( std::string_view query )
+            : m_pattern(query)
+        {
+        }
+
+        /**
+         * The Levenshtein distance between the query and a candidate, or maxDistance + 1 if it is larger than
+         * maxDistance, as with levenshteinDistance().
+         */
+        std::size_t distance(   std::string_view candidate,
+                                std::size_t maxDistance = std::numeric_limits<std::size_t>::max() - 1    ) const
+        {
+            return detail::myersGlobalDistance(candidate, m_pattern, maxDistance);
+        }
+
+    private:
+        detail::MyersPattern m_pattern;
+    };
+
+
+    /**
+     * A candidate found similar to a query: its index among the candidates and its distance to the query.
+     */
+    struct SimilarCandidate
+    {
+        std::size_t index;
+        std::size_t distance;
+
+        bool operator==( const SimilarCandidate & ) const = default;
+    };
+
+
+    /**
+     * Finds the candidates within a Levenshtein distance of a query. Candidates whose length alone rules them out are
+     * skipped without any work, and the others stop as soon as they exceed maxDistance.
+     *
+     * @param query - The string to compare against.
+     * @param candidates - The strings to compare with the query.
+     * @param maxDistance - The largest distance kept.
+     *
+     * @retval std::vector<SimilarCandidate> - The candidates within maxDistance of query, in the order given.
+     */
+    template<typename Str>
+    requires std::convertible_to<const Str &, std::string_view>
+    std::vector<SimilarCandidate> findSimilar(  std::string_view query,
+                                                std::span<const Str> candidates,
+                                                std::size_t maxDistance     )
+    {
+        const LevenshteinMatcher matcher(query);
+        std::vector<SimilarCandidate> similar;
+        for(std::size_t i = 0; i < candidates.size(); ++i)
+        {
+            const std::size_t distance = matcher.distance(candidates[i], maxDistance);
+            if(distance <= maxDistance)
+            {
+                similar.push_back({i, distance});
+            }
+        }
+        return similar;
+    }
+
+
+    /**
+     * Finds the candidates within a Levenshtein distance of a query, as with the span version of findSimilar().
+     */
+    template<typename Str>
+    requires std::convertible_to<const Str &, std::string_view>
+    std::vector<SimilarCandidate> findSimilar(  std::string_view query,
+                                                const std::vector<Str> & candidates,
+                                                std::size_t maxDistance     )
+    {
+        return findSimilar(query, std::span<const Str>(candidates), maxDistance);
+    }
+
+
+    /**
+     * A compiled glob pattern, for matching paths and routes such as "/api/ * /users/ **" (without the spaces) without
+     * splitting them or allocating:
+     *
+     *  ?      matches one character other than '/'.
+     *  *      matches any run of characters other than '/'.
+     *  **     as a whole path segment, matches any run of characters: "a/ ** /b" (without the spaces) matches "a/b",
+     *         "a/x/b" and "a/x/y/b", and a leading "** /" also matches nothing. Elsewhere it is the same as *.
+     *  [abc]  matches one of the characters listed, [a-z] a range of them, and [!abc] or [^abc] any other character,
+     *         never '/'.
+     *  \c     matches the character c itself.
+     *
+     * The pattern is compiled into a list of literal runs, single character tests and stars. Matching tries the stars
+     * greedily, backtracking only to the last star, or to the last ** when a * is stopped by a '/': since * cannot
+     * cross segments, earlier ones never need to move. It takes O(n * m) in the worst case and usually O(n).
+     *
+     * Throws std::invalid_argument if a character class is not closed.
+     */
+    class Glob
+    {
+    public:
+        explicit Glob( std::string_view pattern )
+        {
+            std::size_t i = 0;
+            while(i < pattern.size())
+            {
+                const char c = pattern[i];
+                if(c == '*')
+                {
+                    std::size_t run = 1;
+                    while((i + run < pattern.size()) && (pattern[i + run] == '*'))
+                    {
+                        ++run;
+                    }
+                    const bool segmentStart = (i == 0) || (pattern[i - 1] == '/');
+                    const bool segmentEnd = (i + run == pattern.size()) || (pattern[i + run] == '/');
+                    if((run > 1) && segmentStart && (i + run < pattern.size()) && segmentEnd)
+                    {
+                        //"**/" also takes its slash, so that it can match no segment at all
+                        m_program.push_back({Op::globstarSegment, 0, 0});
+                        i += run + 1;
+                    }
+                    else
+                    {
+                        m_program.push_back({((run > 1) && segmentStart && segmentEnd) ? Op::globstar : Op::star, 0, 0});
+                        i += run;
+                    }
+                }
+                else if(c == '?')
+                {
+                    m_program.push_back({Op::anyCharacter, 0, 0});
+                    ++m_minimumLength;
+                    ++i;
+                }
+                else if(c == '[')
+                {
+                    i = compileClass(pattern, i);
+                    ++m_minimumLength;
+                }
+                else
+                {
+                    char literal = c;
+                    if((c == '\\') && (i + 1 < pattern.size()))
+                    {
+                        literal = pattern[++i];
+                    }
+                    if(m_program.empty() || (m_program.back().op != Op::literal))
+                    {
+                        m_program.push_back({Op::literal, static_cast<std::uint32_t>(m_literals.size()), 0});
+                    }
+                    m_literals += literal;
+                    ++m_program.back().length;
+                    ++m_minimumLength;
+                    ++i;
+                }
+            }
+        }
+
+        /**
+         * Checks if a whole string matches the pattern.
+         */
+        bool matches( std::string_view str ) const
+        {
+            if(str.size() < m_minimumLength)
+            {
+                return false;
+            }
+            //A pattern ending with literal characters can be rejected by its end alone
+            if(!m_program.empty() && (m_program.back().op == Op::literal) && !str.ends_with(literal(m_program.back())))
+            {
+                return false;
+            }
+
+            struct Backtrack
+            {
+                std::size_t instruction = npos;
+                std::size_t position = 0;
+                Op op = Op::star;
+            };
+            Backtrack star;
+            Backtrack globstar;
+            std::size_t instruction = 0;
+            std::size_t position = 0;
+            while(true)
+            {
+                if(instruction < m_program.size())
+                {
+                    const Instruction & current = m_program[instruction];
+                    bool advanced = false;
+                    switch(current.op)
+                    {
+                        case Op::literal:
+                            advanced = str.substr(position).starts_with(literal(current));
+                            position += advanced ? current.length : 0;
+                            break;
+                        case Op::anyCharacter:
+                            advanced = (position < str.size()) && (str[position] != '/');
+                            position += advanced;
+                            break;
+                        case Op::characterClass:
+                            advanced = (position < str.size()) && inClass(current.offset, str[position]);
+                            position += advanced;
+                            break;
+                        case Op::star:
+                            star = {instruction + 1, position, Op::star};
+                            advanced = true;
+                            break;
+                        case Op::globstar:
+                        case Op::globstarSegment:
+                            star = globstar = {instruction + 1, position, current.op};
+                            advanced = true;
+                            break;
+                    }
+                    if(advanced)
+                    {
+                        ++instruction;
+                        continue;
+                    }
+                }
+                else if(position == str.size())
+                {
+                    return true;
+                }
+
+                //Let the last star take one more character, or the last ** if that star is stopped by a '/'
+                if((star.instruction != npos) && extend(star, str))
+                {
+                    if(star.op != Op::star)
+                    {
+                        globstar = star;
+                    }
+                    instruction = star.instruction;
+                    position = star.position;
+                }
+                else if((globstar.instruction != npos) && (star.op == Op::star) && extend(globstar, str))
+                {
+                    star = globstar;
+                    instruction = star.instruction;
+                    position = star.position;
+                }
+                else
+                {
+                    return false;
+                }
+            }
+        }
+
+        /**
+         * The literal characters every match starts with, empty if the pattern starts with a wildcard.
+         */
+        std::string_view literalPrefix() const
+        {
+            return (!m_program.empty() && (m_program.front().op == Op::literal)) ? literal(m_program.front()) : std::string_view();
+        }
+
+    private:
+        static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+        enum class Op : std::uint8_t
+        {
+            literal,
+            anyCharacter,
+            characterClass,
+            star,
+            globstar,
+            globstarSegment
+        };
+
+        //A run of literal characters at offset in m_literals, or the class at offset in m_classes
+        struct Instruction
+        {
+            Op op;
+            std::uint32_t offset;
+            std::uint32_t length;
+        };
+
+        std::string_view literal( const Instruction & instruction ) const
+        {
+            return std::string_view(m_literals).substr(instruction.offset, instruction.length);
+        }
+
+        bool inClass(   std::size_t index,
+                        char c  ) const
+        {
+            const unsigned char byte = static_cast<unsigned char>(c);
+            return (m_classes[index][byte / 64] >> (byte % 64)) & 1;
+        }
+
+        /**
+         * Makes a star consume more of the string: one more character, any for ** and other than '/' for *, or for a
+         * "**" segment, everything up to and including the next '/'.
+         */
+        template<typename Backtrack>
+        static bool extend(     Backtrack & star,
+                                std::string_view str    )
+        {
+            if(star.position >= str.size())
+            {
+                return false;
+            }
+            switch(star.op)
+            {
+                case Op::star:
+                    if(str[star.position] == '/')
+                    {
+                        return false;
+                    }
+                    ++star.position;
+                    return true;
+                case Op::globstarSegment:
+                {
+                    const std::size_t slash = str.find('/', star.position);
+                    if(slash == std::string_view::npos)
+                    {
+                        return false;
+                    }
+                    star.position = slash + 1;
+                    return true;
+                }
+                default:
+                    ++star.position;
+                    return true;
+            }
+        }
+
+        /**
+         * Compiles the character class starting at the '[' at position i of the pattern, returning the position after
+         * its ']'.
+         */
+        std::size_t compileClass(   std::string_view pattern,
+                                    std::size_t i   )
+        {
+            std::array<std::uint64_t, 4> members{};
+            const auto add = [&](unsigned char c) { members[c / 64] |= std::uint64_t(1) << (c % 64); };
+            ++i;
+            const bool negated = (i < pattern.size()) && ((pattern[i] == '!') || (pattern[i] == '^'));
+            i += negated;
+            //A ']' right after the '[' is one of the characters
+            for(bool first = true; (i < pattern.size()) && (first || (pattern[i] != ']')); first = false)
+            {
+                unsigned char low = static_cast<unsigned char>(pattern[i]);
+                if((low == '\\') && (i + 1 < pattern.size()))
+                {
+                    low = static_cast<unsigned char>(pattern[++i]);
+                }
+                ++i;
+                unsigned char high = low;
+                if((i + 1 < pattern.size()) && (pattern[i] == '-') && (pattern[i + 1] != ']'))
+                {
+                    high = static_cast<unsigned char>(pattern[i + 1]);
+                    if((high == '\\') && (i + 2 < pattern.size()))
+                    {
+                        high = static_cast<unsigned char>(pattern[++i + 1]);
+                    }
+                    i += 2;
+                }
+                for(unsigned c = low; c <= high; ++c)
+                {
+                    add(static_cast<unsigned char>(c));
+                }
+            }
+            if(i >= pattern.size())
+            {
+                throw std::invalid_argument("Glob(): unterminated character class in " + std::string(pattern));
+            }
+            if(negated)
+            {
+                for(std::uint64_t & word : members)
+                {
+                    word = ~word;
+                }
+            }
+            members['/' / 64] &= ~(std::uint64_t(1) << ('/' % 64));
+            m_program.push_back({Op::characterClass, static_cast<std::uint32_t>(m_classes.size()), 0});
+            m_classes.push_back(members);
+            return i + 1;
+        }
+
+        std::vector<Instruction> m_program;
+        std::string m_literals;
+        std::vector<std::array<std::uint64_t, 4>> m_classes;
+        std::size_t m_minimumLength = 0;
+    };
+
+
+    /**
+     * Checks if a string matches a glob pattern, compiling it each time: see Glob for the syntax, and to match the
+     * same pattern many times.
+     *
+     * @param pattern - The glob pattern.
+     * @param str - The string to match against it.
+     *
+     * @retval bool - True if the whole of str matches pattern.
+     */
+    bool globMatch(     std::string_view pattern,
+                        std::string_view str    )
+    {
+        return Glob(pattern).matches(str);
+    }
+
+
+    /**
+     * A set of compiled glob patterns, tested against a string together. The patterns are kept in a trie of their
+     * literal prefixes, so one walk down the string's first characters finds the only patterns that can match it, and
+     * only those run. With routing tables, where patterns mostly start with distinct literal paths, this is close to
+     * one pattern per lookup whatever their number.
+     */
+    class GlobSet
+    {
+    public:
+        GlobSet() = default;
+
+        explicit GlobSet( std::span<const std::string_view> patterns )
+        {
+            for(std::string_view pattern : patterns)
+            {
+                add(pattern);
+            }
+        }
+
+        explicit GlobSet( const std::vector<std::string> & patterns )
+        {
+            for(const std::string & pattern : patterns)
+            {
+                add(pattern);
+            }
+        }
+
+        /**
+         * Adds a pattern to the set, returning its index.
+         *
+         * Throws std::invalid_argument if the pattern is invalid, as with Glob.
+         */
+        std::size_t add( std::string_view pattern )
+        {
+            m_globs.emplace_back(pattern);
+            std::size_t node = 0;
+            for(char c : m_globs.back().literalPrefix())
+            {
+                node = child(node, c);
+            }
+            m_nodes[node].patterns.push_back(m_globs.size() - 1);
+            return m_globs.size() - 1;
+        }
+
+        std::size_t size() const
+        {
+            return m_globs.size();
+        }
+
+        /**
+         * Calls callback(index) for every pattern matching str, by increasing length of their literal prefix, without
+         * allocating. Stops if the callback returns false.
+         */
+        template<typename Callback>
+        void forEachMatch(  std::string_view str,
+                            Callback && callback    ) const
+        {
+            std::size_t node = 0;
+            for(std::size_t i = 0; ; ++i)
+            {
+                for(std::size_t index : m_nodes[node].patterns)
+                {
+                    if(m_globs[index].matches(str) && !callback(index))
+                    {
+                        return;
+                    }
+                }
+                if(i == str.size())
+                {
+                    return;
+                }
+                const std::vector<std::pair<char, std::size_t>> & children = m_nodes[node].children;
+                const auto next = std::lower_bound(children.begin(), children.end(), std::pair<char, std::size_t>(str[i], 0));
+                if((next == children.end()) || (next->first != str[i]))
+                {
+                    return;
+                }
+                node = next->second;
+            }
+        }
+
+        /**
+         * Checks if any pattern of the set matches str.
+         */
+        bool matches( std::string_view str ) const
+        {
+            bool found = false;
+            forEachMatch(str, [&](std::size_t)
+            {
+                found = true;
+                return false;
+            });
+            return found;
+        }
+
+        /**
+         * Returns the indices of all the patterns matching str, in increasing order.
+         */
+        std::vector<std::size_t> matchingPatterns( std::string_view str ) const
+        {
+            std::vector<std::size_t> indices;
+            forEachMatch(str, [&](std::size_t index)
+            {
+                indices.push_back(index);
+                return true;
+            });
+            std::sort(indices.begin(), indices.end());
+            return indices;
+        }
+
+    private:
+        struct Node
+        {
+            //Sorted by character
+            std::vector<std::pair<char, std::size_t>> children;
+            std::vector<std::size_t> patterns;
+        };
+
+        std::size_t child(  std::size_t node,
+                            char c  )
+        {
+            std::vector<std::pair<char, std::size_t>> & children = m_nodes[node].children;
+            const auto next = std::lower_bound(children.begin(), children.end(), std::pair<char, std::size_t>(c, 0));
+            if((next != children.end()) && (next->first == c))
+            {
+                return next->second;
+            }
+            children.insert(next, {c, m_nodes.size()});
+            const std::size_t created = m_nodes.size();
+            m_nodes.emplace_back();
+            return created;
+        }
+
+        std::vector<Glob> m_globs;
+        std::vector<Node> m_nodes = std::vector<Node>(1);
+    };
+
+
+    namespace detail
+    {
+        /**
+         * Returns the position of the first occurrence of needle in haystack at or after from, or std::string_view::npos.
+         * With SSE2, 16 candidate positions at a time are filtered by comparing both the first and the last byte of the
+         * needle, which rejects almost all of them before any comparison of the whole needle.
+         */
+        inline std::size_t findLiteral(     std::string_view haystack,
+                                            std::string_view needle,
+                                            std::size_t from    )
+        {
+            if((needle.size() > haystack.size()) || (from > haystack.size() - needle.size()))
+            {
+                return std::string_view::npos;
+            }
+#ifdef STEVENSSTRINGLIB_X86_64
+            if(needle.size() > 1)
+            {
+                const __m128i first = _mm_set1_epi8(needle.front());
+                const __m128i last = _mm_set1_epi8(needle.back());
+                const char * p = haystack.data() + from;
+                //Candidates start before stop, and a block of 16 of them reads up to p + 16 + needle.size() - 1
+                const char * const stop = haystack.data() + haystack.size() - needle.size() + 1;
+                while(stop - p >= 16)
+                {
+                    const __m128i starts = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+                    const __m128i ends = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + needle.size() - 1));
+                    unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(starts, first)) & _mm_movemask_epi8(_mm_cmpeq_epi8(ends, last)));
+                    while(mask != 0)
+                    {
+                        const int offset = std::countr_zero(mask);
+                        if(std::memcmp(p + offset + 1, needle.data() + 1, needle.size() - 2) == 0)
+                        {
+                            return (p - haystack.data()) + offset;
+                        }
+                        mask &= mask - 1;
+                    }
+                    p += 16;
+                }
+                from = p - haystack.data();
+            }
+#endif
+            return haystack.find(needle, from);
+        }
+
+
+        //A set of bytes, one bit per byte
+        using ByteSet = std::array<std::uint64_t, 4>;
+
+        inline bool byteSetContains(    const ByteSet & set,
+                                        unsigned char byte  )
+        {
+            return (set[byte / 64] >> (byte % 64)) & 1;
+        }
+
+        inline void byteSetAdd(     ByteSet & set,
+                                    unsigned char low,
+                                    unsigned char high  )
+        {
+            for(unsigned byte = low; byte <= high; ++byte)
+            {
+                set[byte / 64] |= std::uint64_t(1) << (byte % 64);
+            }
+        }
+
+
+        /**
+         * A node of a parsed regular expression: a set of bytes, a concatenation or alternation of its children, a
+         * repetition of its child, or the empty string.
+         */
+        struct RegexNode
+        {
+            enum class Kind : std::uint8_t
+            {
+                byteSet,
+                concatenation,
+                alternation,
+                star,
+                plus,
+                optional,
+                empty
+            };
+
+            Kind kind;
+            std::uint32_t set = 0;
+            std::vector<std::uint32_t> children;
+        };
+
+
+        /**
+         * A recursive descent parser of the regular expressions accepted by Regex, into a tree of RegexNodes.
+         */
+        class RegexParser
+        {
+        public:
+            explicit RegexParser( std::string_view pattern )
+                : m_pattern(pattern)
+            {
+            }
+
+            /**
+             * Parses the whole pattern, returning its root node.
+             */
+            std::uint32_t parse()
+            {
+                if(!m_pattern.empty() && (m_pattern.front() == '^'))
+                {
+                    anchoredStart = true;
+                    ++m_position;
+                }
+                const std::uint32_t root = parseAlternation();
+                if(m_position < m_pattern.size())
+                {
+                    fail("unmatched ')'");
+                }
+                return root;
+            }
+
+            std::vector<RegexNode> nodes;
+            std::vector<ByteSet> sets;
+            bool anchoredStart = false;
+            bool anchoredEnd = false;
+
+        private:
+            static constexpr std::size_t maxNodes = 100000;
+            static constexpr std::size_t maxRepeat = 1000;
+            //Bounds the recursion of the parser, and of everything that walks the tree, on groups and nodes
+            static constexpr std::size_t maxDepth = 256;
+
+            [[noreturn]] void fail( const std::string & reason ) const
+            {
+                throw std::invalid_argument("Regex(): " + reason + " at position " + std::to_string(m_position) + " of " + std::string(m_pattern));
+            }
+
+            bool atEnd() const
+            {
+                return m_position >= m_pattern.size();
+            }
+
+            char peek() const
+            {
+                return m_pattern[m_position];
+            }
+
+            std::uint32_t addNode(  RegexNode::Kind kind,
+                                    std::vector<std::uint32_t> children = {}    )
+            {
+                if(nodes.size() >= maxNodes)
+                {
+                    fail("pattern too large");
+                }
+                std::size_t height = 1;
+                for(std::uint32_t child : children)
+                {
+                    height = std::max<std::size_t>(height, m_heights[child] + 1);
+                }
+                if(height > maxDepth)
+                {
+                    fail("pattern nested too deeply");
+                }
+                m_heights.push_back(static_cast<std::uint32_t>(height));
+                nodes.push_back({kind, 0, std::move(children)});
+                return static_cast<std::uint32_t>(nodes.size() - 1);
+            }
+
+            std::uint32_t addSet( const ByteSet & set )
+            {
+                const std::uint32_t node = addNode(RegexNode::Kind::byteSet);
+                nodes[node].set = static_cast<std::uint32_t>(sets.size());
+                sets.push_back(set);
+                return node;
+            }
+
+            std::uint32_t parseAlternation()
+            {
+                std::vector<std::uint32_t> branches = {parseConcatenation()};
+                while(!atEnd() && (peek() == '|'))
+                {
+                    ++m_position;
+                    branches.push_back(parseConcatenation());
+                }
+                //The anchors are flags of the whole pattern, so they cannot apply to just one of its branches
+                if((branches.size() > 1) && (m_depth == 0) && (anchoredStart || anchoredEnd))
+                {
+                    fail("'^' and '$' cannot anchor a branch of '|', put the alternation in a group");
+                }
+                return (branches.size() == 1) ? branches.front() : addNode(RegexNode::Kind::alternation, std::move(branches));
+            }
+
+            std::uint32_t parseConcatenation()
+            {
+                std::vector<std::uint32_t> items;
+                while(!atEnd() && (peek() != '|') && (peek() != ')'))
+                {
+                    items.push_back(parseRepetition());
+                }
+                if(items.empty())
+                {
+                    return addNode(RegexNode::Kind::empty);
+                }
+                return (items.size() == 1) ? items.front() : addNode(RegexNode::Kind::concatenation, std::move(items));
+            }
+
+            std::uint32_t parseRepetition()
+            {
+                std::uint32_t node = parseAtom();
+                while(!atEnd())
+                {
+                    const char c = peek();
+                    if((c == '*') || (c == '+') || (c == '?'))
+                    {
+                        ++m_position;
+                        const RegexNode::Kind kind = (c == '*') ? RegexNode::Kind::star : ((c == '+') ? RegexNode::Kind::plus : RegexNode::Kind::optional);
+                        node = addNode(kind, {node});
+                    }
+                    else if(c == '{')
+                    {
+                        std::size_t minimum = 0;
+                        std::size_t maximum = 0;
+                        if(!parseCount(minimum, maximum))
+                        {
+                            break;
+                        }
+                        node = expandCount(node, minimum, maximum);
+                    }
+                    else
+                    {
+                        break;
+                    }
+                    if(!atEnd() && ((peek() == '?') || (peek() == '+')))
+                    {
+                        fail("lazy and possessive quantifiers are not supported, matches are leftmost-longest");
+                    }
+                }
+                return node;
+            }
+
+            /**
+             * Parses {n}, {n,} or {n,m}, leaving the position unchanged and returning false if the '{' does not start
+             * one. An unbounded maximum is returned as maxRepeat + 1.
+             */
+            bool parseCount(    std::size_t & minimum,
+                                std::size_t & maximum   )
+            {
+                std::size_t i = m_position + 1;
+                const auto number = [&](std::size_t & value)
+                {
+                    const std::size_t start = i;
+                    value = 0;
+                    //Every digit is read, but the value stops growing past maxRepeat, so it cannot overflow
+                    while((i < m_pattern.size()) && isDigit(m_pattern[i]))
+                    {
+                        value = std::min<std::size_t>(value * 10 + (m_pattern[i++] - '0'), maxRepeat + 1);
+                    }
+                    return i != start;
+                };
+                if(!number(minimum))
+                {
+                    return false;
+                }
+                maximum = minimum;
+                bool unbounded = false;
+                if((i < m_pattern.size()) && (m_pattern[i] == ','))
+                {
+                    ++i;
+                    unbounded = !number(maximum);
+                }
+                if((i >= m_pattern.size()) || (m_pattern[i] != '}'))
+                {
+                    return false;
+                }
+                if((minimum > maxRepeat) || (maximum > maxRepeat) || (!unbounded && (minimum > maximum)))
+                {
+                    fail("invalid repetition count");
+                }
+                if(unbounded)
+                {
+                    maximum = maxRepeat + 1;
+                }
+                m_position = i + 1;
+                return true;
+            }
+
+            /**
+             * Writes x{n,m} as n copies of x followed by m - n optional ones, or by x* when m is unbounded.
+             */
+            std::uint32_t expandCount(  std::uint32_t node,
+                                        std::size_t minimum,
+                                        std::size_t maximum     )
+            {
+                std::vector<std::uint32_t> items;
+                for(std::size_t i = 0; i < minimum; ++i)
+                {
+                    items.push_back(i == 0 ? node : clone(node));
+                }
+                if(maximum == maxRepeat + 1)
+                {
+                    items.push_back(addNode(RegexNode::Kind::star, {minimum == 0 ? node : clone(node)}));
+                }
+                else
+                {
+                    for(std::size_t i = minimum; i < maximum; ++i)
+                    {
+                        items.push_back(addNode(RegexNode::Kind::optional, {i == 0 ? node : clone(node)}));
+                    }
+                }
+                if(items.empty())
+                {
+                    return addNode(RegexNode::Kind::empty);
+                }
+                return (items.size() == 1) ? items.front() : addNode(RegexNode::Kind::concatenation, std::move(items));
+            }
+
+            std::uint32_t clone( std::uint32_t node )
+            {
+                std::vector<std::uint32_t> children;
+                for(std::uint32_t child : std::vector<std::uint32_t>(nodes[node].children))
+                {
+                    children.push_back(clone(child));
+                }
+                const std::uint32_t copy = addNode(nodes[node].kind, std::move(children));
+                nodes[copy].set = nodes[node].set;
+                return copy;
+            }
+
+            std::uint32_t parseAtom()
+            {
+                const char c = peek();
+                ++m_position;
+                switch(c)
+                {
+                    case '(':
+                    {
+                        if(!atEnd() && (peek() == '?'))
+                        {
+                            if(m_pattern.substr(m_position, 2) != "?:")
+                            {
+                                fail("only (?:...) groups are supported");
+                            }
+                            m_position += 2;
+                        }
+                        if(++m_depth > maxDepth)
+                        {
+                            fail("groups nested too deeply");
+                        }
+                        const std::uint32_t node = parseAlternation();
+                        if(atEnd() || (peek() != ')'))
+                        {
+                            fail("missing ')'");
+                        }
+                        --m_depth;
+                        ++m_position;
+                        return node;
+                    }
+                    case '[':
+                        return addSet(parseClass());
+                    case '.':
+                    {
+                        ByteSet set{};
+                        byteSetAdd(set, 0, 255);
+                        set['\n' / 64] &= ~(std::uint64_t(1) << ('\n' % 64));
+                        return addSet(set);
+                    }
+                    case '\\':
+                        return addSet(parseEscape());
+                    case '*':
+                    case '+':
+                    case '?':
+                        --m_position;
+                        fail("nothing to repeat");
+                    case '^':
+                        --m_position;
+                        fail("'^' is only supported at the start of the pattern");
+                    case '$':
+                        if(!atEnd())
+                        {
+                            --m_position;
+                            fail("'$' is only supported at the end of the pattern");
+                        }
+                        anchoredEnd = true;
+                        return addNode(RegexNode::Kind::empty);
+                    default:
+                    {
+                        ByteSet set{};
+                        byteSetAdd(set, static_cast<unsigned char>(c), static_cast<unsigned char>(c));
+                        return addSet(set);
+                    }
+                }
+            }
+
+            /**
+             * Parses the escape after a '\', returning the bytes it matches.
+             */
+            ByteSet parseEscape()
+            {
+                if(atEnd())
+                {
+                    fail("trailing '\\'");
+                }
+                const char c = m_pattern[m_position++];
+                ByteSet set{};
+                switch(c)
+                {
+                    case 'd':
+                    case 'D':
+                        byteSetAdd(set, '0', '9');
+                        break;
+                    case 'w':
+                    case 'W':
+                        byteSetAdd(set, '0', '9');
+                        byteSetAdd(set, 'A', 'Z');
+                        byteSetAdd(set, 'a', 'z');
+                        byteSetAdd(set, '_', '_');
+                        break;
+                    case 's':
+                    case 'S':
+                        byteSetAdd(set, '\t', '\r');
+                        byteSetAdd(set, ' ', ' ');
+                        break;
+                    case 'n':
+                        byteSetAdd(set, '\n', '\n');
+                        return set;
+                    case 't':
+                        byteSetAdd(set, '\t', '\t');
+                        return set;
+                    case 'r':
+                        byteSetAdd(set, '\r', '\r');
+                        return set;
+                    case 'f':
+                        byteSetAdd(set, '\f', '\f');
+                        return set;
+                    case 'v':
+                        byteSetAdd(set, '\v', '\v');
+                        return set;
+                    case 'x':
+                    {
+                        unsigned value = 0;
+                        for(int digit = 0; digit < 2; ++digit)
+                        {
+                            const char h = atEnd() ? '\0' : m_pattern[m_position++];
+                            if(!std::isxdigit(static_cast<unsigned char>(h)))
+                            {
+                                fail("invalid \\x escape");
+                            }
+                            value = value * 16 + (isDigit(h) ? h - '0' : (std::tolower(static_cast<unsigned char>(h)) - 'a' + 10));
+                        }
+                        byteSetAdd(set, static_cast<unsigned char>(value), static_cast<unsigned char>(value));
+                        return set;
+                    }
+                    default:
+                        if(std::isalnum(static_cast<unsigned char>(c)))
+                        {
+                            fail(std::string("unsupported escape \\") + c);
+                        }
+                        byteSetAdd(set, static_cast<unsigned char>(c), static_cast<unsigned char>(c));
+                        return set;
+                }
+                //The upper case classes are the complements of the lower case ones
+                if(std::isupper(static_cast<unsigned char>(c)))
+                {
+                    for(std::uint64_t & word : set)
+                    {
+                        word = ~word;
+                    }
+                }
+                return set;
+            }
+
+            /**
+             * Parses a character class after its '[', returning the bytes it matches.
+             */
+            ByteSet parseClass()
+            {
+                ByteSet set{};
+                const bool negated = !atEnd() && (peek() == '^');
+                m_position += negated;
+                for(bool first = true; !atEnd() && (first || (peek() != ']')); first = false)
+                {
+                    unsigned char low = static_cast<unsigned char>(m_pattern[m_position++]);
+                    if(low == '\\')
+                    {
+                        const ByteSet escaped = parseEscape();
+                        if(std::popcount(escaped[0]) + std::popcount(escaped[1]) + std::popcount(escaped[2]) + std::popcount(escaped[3]) != 1)
+                        {
+                            for(std::size_t word = 0; word < 4; ++word)
+                            {
+                                set[word] |= escaped[word];
+                            }
+                            continue;
+                        }
+                        low = 0;
+                        while(!byteSetContains(escaped, low))
+                        {
+                            ++low;
+                        }
+                    }
+                    unsigned char high = low;
+                    if((m_position + 1 < m_pattern.size()) && (peek() == '-') && (m_pattern[m_position + 1] != ']'))
+                    {
+                        high = static_cast<unsigned char>(m_pattern[m_position + 1]);
+                        m_position += 2;
+                        if(high == '\\')
+                        {
+                            const ByteSet escaped = parseEscape();
+                            high = 0;
+                            while((high < 255) && !byteSetContains(escaped, high))
+                            {
+                                ++high;
+                            }
+                        }
+                        if(high < low)
+                        {
+                            fail("invalid range in character class");
+                        }
+                    }
+                    byteSetAdd(set, low, high);
+                }
+                if(atEnd())
+                {
+                    fail("missing ']'");
+                }
+                ++m_position;
+                if(negated)
+                {
+                    for(std::uint64_t & word : set)
+                    {
+                        word = ~word;
+                    }
+                }
+                return set;
+            }
+
+            std::string_view m_pattern;
+            std::size_t m_position = 0;
+            //The number of groups the position is in
+            std::size_t m_depth = 0;
+            //The height of the tree under each node
+            std::vector<std::uint32_t> m_heights;
+        };
+
+
+        /**
+         * A Thompson NFA: states testing one byte against a set, splitting into two, or accepting.
+         */
+        struct RegexNfa
+        {
+            struct State
+            {
+                enum class Kind : std::uint8_t
+                {
+                    byteSet,
+                    split,
+                    match
+                };
+
+                Kind kind;
+                std::uint32_t set;
+                std::uint32_t out;
+                std::uint32_t out1;
+            };
+
+            std::vector<State> states;
+            std::uint32_t start = 0;
+
+            /**
+             * Compiles the tree of a parser, or its reverse, which matches the reversed strings.
+             */
+            RegexNfa(   const RegexParser & parser,
+                        std::uint32_t root,
+                        bool reversed   )
+            {
+                states.push_back({State::Kind::match, 0, 0, 0});
+                start = compile(parser, root, 0, reversed);
+            }
+
+        private:
+            std::uint32_t add( State state )
+            {
+                states.push_back(state);
+                return static_cast<std::uint32_t>(states.size() - 1);
+            }
+
+            /**
+             * Compiles a node followed by the state next, returning the state it starts at.
+             */
+            std::uint32_t compile(  const RegexParser & parser,
+                                    std::uint32_t node,
+                                    std::uint32_t next,
+                                    bool reversed   )
+            {
+                const RegexNode & current = parser.nodes[node];
+                switch(current.kind)
+                {
+                    case RegexNode::Kind::byteSet:
+                        return add({State::Kind::byteSet, current.set, next, 0});
+                    case RegexNode::Kind::concatenation:
+                        if(reversed)
+                        {
+                            for(std::uint32_t child : current.children)
+                            {
+                                next = compile(parser, child, next, reversed);
+                            }
+                        }
+                        else
+                        {
+                            for(auto child = current.children.rbegin(); child != current.children.rend(); ++child)
+                            {
+                                next = compile(parser, *child, next, reversed);
+                            }
+                        }
+                        return next;
+                    case RegexNode::Kind::alternation:
+                    {
+                        std::uint32_t branches = compile(parser, current.children.back(), next, reversed);
+                        for(std::size_t i = current.children.size() - 1; i-- > 0;)
+                        {
+                            const std::uint32_t branch = compile(parser, current.children[i], next, reversed);
+                            branches = add({State::Kind::split, 0, branch, branches});
+                        }
+                        return branches;
+                    }
+                    case RegexNode::Kind::optional:
+                    {
+                        const std::uint32_t body = compile(parser, current.children.front(), next, reversed);
+                        return add({State::Kind::split, 0, body, next});
+                    }
+                    case RegexNode::Kind::star:
+                    case RegexNode::Kind::plus:
+                    {
+                        const std::uint32_t loop = add({State::Kind::split, 0, 0, next});
+                        const std::uint32_t body = compile(parser, current.children.front(), loop, reversed);
+                        states[loop].out = body;
+                        return (current.kind == RegexNode::Kind::star) ? loop : body;
+                    }
+                    default:
+                        return next;
+                }
+            }
+        };
+
+
+        /**
+         * A DFA built lazily from a RegexNfa, one state and transition at a time as the text needs them, and kept in a
+         * cache of at most maxStates states, which is emptied when full. Bytes the pattern never tells apart share a
+         * class and a column of the transition table.
+         *
+         * Each DFA state is the set of NFA states the threads can be in, grouped by the position the threads started
+         * at, earliest first; a thread reaching an NFA state an earlier one already holds is dropped. When the DFA is
+         * unanchored, a thread starts at every position until one matches. From then on, the groups after the matching
+         * one can only give matches starting further right and are dropped too, so the last position where the last
+         * group matches is the end of the leftmost-longest match.
+         */
+        class RegexDfa
+        {
+        public:
+            static constexpr std::int32_t dead = 0;
+
+            RegexDfa(   RegexNfa nfa,
+                        const std::vector<ByteSet> & sets,
+                        bool unanchored,
+                        std::size_t maxStates   )
+                : m_nfa(std::move(nfa)),
+                  m_sets(sets),
+                  m_unanchored(unanchored),
+                  m_maxStates(std::max<std::size_t>(maxStates, 8)),
+                  m_marks(m_nfa.states.size(), 0)
+            {
+                //Bytes belong to the same class when every set of the pattern holds either both or neither
+                std::size_t classes = 0;
+                for(unsigned byte = 0; byte < 256; ++byte)
+                {
+                    bool boundary = (byte == 0);
+                    for(const ByteSet & set : m_sets)
+                    {
+                        boundary = boundary || (byteSetContains(set, byte) != byteSetContains(set, byte - 1));
+                    }
+                    if(boundary)
+                    {
+                        m_representatives.push_back(static_cast<unsigned char>(byte));
+                        ++classes;
+                    }
+                    m_classes[byte] = static_cast<std::uint8_t>(classes - 1);
+                }
+                m_classCount = classes;
+                reset();
+                std::vector<std::uint32_t> group;
+                ++m_generation;
+                closure(m_nfa.start, group);
+                for(std::uint32_t state : group)
+                {
+                    if(m_nfa.states[state].kind == RegexNfa::State::Kind::byteSet)
+                    {
+                        for(unsigned byte = 0; byte < 256; ++byte)
+                        {
+                            m_firstBytes[byte] = m_firstBytes[byte] || byteSetContains(m_sets[m_nfa.states[state].set], static_cast<unsigned char>(byte));
+                        }
+                    }
+                }
+            }
+
+            std::int32_t start() const
+            {
+                return m_start;
+            }
+
+            bool isMatch( std::int32_t state ) const
+            {
+                return m_flags[state] & matchFlag;
+            }
+
+            /**
+             * Whether a state is the start state, the dead state, or a matching one: the states a search loop must look
+             * at, rather than just follow.
+             */
+            bool isSpecial( std::int32_t state ) const
+            {
+                return m_flags[state] != 0;
+            }
+
+            /**
+             * Whether a byte can start a match: reading any other byte in the start state leads back to it.
+             */
+            bool canStart( unsigned char byte ) const
+            {
+                return m_firstBytes[byte];
+            }
+
+            /**
+             * The state after reading a byte from a state, computing it if it is not cached yet.
+             */
+            std::int32_t next(  std::int32_t state,
+                                unsigned char byte  )
+            {
+                const std::int32_t target = m_transitions[state * m_classCount + m_classes[byte]];
+                return (target >= 0) ? target : computeNext(state, m_classes[byte]);
+            }
+
+        private:
+            //Separates the groups of NFA states, and ends the key of an unanchored state still starting threads
+            static constexpr std::uint32_t groupEnd = 0xFFFFFFFF;
+            static constexpr std::uint32_t starting = 0xFFFFFFFE;
+            static constexpr std::uint8_t matchFlag = 1;
+            static constexpr std::uint8_t otherFlag = 2;
+
+
+            /**
+             * Empties the cache, keeping only the dead and the start state.
+             */
+            void reset()
+            {
+                m_states.clear();
+                m_flags.clear();
+                m_ids.clear();
+                m_transitions.clear();
+                add({}, false);
+                std::vector<std::uint32_t> group;
+                ++m_generation;
+                closure(m_nfa.start, group);
+                m_start = add(group, m_unanchored);
+                m_flags[dead] |= otherFlag;
+                m_flags[m_start] |= otherFlag;
+            }
+
+            /**
+             * Adds the NFA states reachable from state without reading a byte, and not marked yet, to group.
+             */
+            void closure(   std::uint32_t state,
+                            std::vector<std::uint32_t> & group  )
+            {
+                m_stack.push_back(state);
+                while(!m_stack.empty())
+                {
+                    const std::uint32_t current = m_stack.back();
+                    m_stack.pop_back();
+                    if(m_marks[current] == m_generation)
+                    {
+                        continue;
+                    }
+                    m_marks[current] = m_generation;
+                    const RegexNfa::State & nfaState = m_nfa.states[current];
+                    if(nfaState.kind == RegexNfa::State::Kind::split)
+                    {
+                        m_stack.push_back(nfaState.out1);
+                        m_stack.push_back(nfaState.out);
+                    }
+                    else
+                    {
+                        group.push_back(current);
+                    }
+                }
+            }
+
+            /**
+             * Returns the id of the state of a list of groups, adding it if needed. The groups after the first one
+             * holding the match state are dropped, and threads stop starting.
+             */
+            std::int32_t add(   std::vector<std::uint32_t> list,
+                                bool startsThreads  )
+            {
+                bool matching = false;
+                std::size_t groupStart = 0;
+                for(std::size_t i = 0; i <= list.size(); ++i)
+                {
+                    if((i == list.size()) || (list[i] == groupEnd))
+                    {
+                        std::sort(list.begin() + groupStart, list.begin() + i);
+                        if(std::binary_search(list.begin() + groupStart, list.begin() + i, 0u))
+                        {
+                            list.resize(i);
+                            matching = true;
+                            startsThreads = false;
+                            break;
+                        }
+                        groupStart = i + 1;
+                    }
+                }
+                if(startsThreads)
+                {
+                    list.push_back(starting);
+                }
+
+                std::string key(reinterpret_cast<const char *>(list.data()), list.size() * sizeof(std::uint32_t));
+                const auto found = m_ids.find(key);
+                if(found != m_ids.end())
+                {
+                    return found->second;
+                }
+                const std::int32_t id = static_cast<std::int32_t>(m_states.size());
+                m_ids.emplace(key, id);
+                m_states.push_back(std::move(key));
+                m_flags.push_back(matching ? matchFlag : 0);
+                m_transitions.resize(m_states.size() * m_classCount, -1);
+                return id;
+            }
+
+            std::int32_t computeNext(   std::int32_t state,
+                                        std::uint8_t byteClass  )
+            {
+                const unsigned char byte = m_representatives[byteClass];
+                std::vector<std::uint32_t> list((m_states[state].size()) / sizeof(std::uint32_t));
+                std::memcpy(list.data(), m_states[state].data(), m_states[state].size());
+                const bool startsThreads = !list.empty() && (list.back() == starting);
+                if(startsThreads)
+                {
+                    list.pop_back();
+                }
+
+                ++m_generation;
+                std::vector<std::uint32_t> next;
+                std::vector<std::uint32_t> group;
+                const auto endGroup = [&]()
+                {
+                    if(!group.empty())
+                    {
+                        if(!next.empty())
+                        {
+                            next.push_back(groupEnd);
+                        }
+                        next.insert(next.end(), group.begin(), group.end());
+                        group.clear();
+                    }
+                };
+                for(std::uint32_t nfaState : list)
+                {
+                    if(nfaState == groupEnd)
+                    {
+                        endGroup();
+                        continue;
+                    }
+                    const RegexNfa::State & current = m_nfa.states[nfaState];
+                    if((current.kind == RegexNfa::State::Kind::byteSet) && byteSetContains(m_sets[current.set], byte))
+                    {
+                        closure(current.out, group);
+                    }
+                }
+                endGroup();
+                if(startsThreads)
+                {
+                    closure(m_nfa.start, group);
+                    endGroup();
+                }
+
+                if(m_states.size() >= m_maxStates)
+                {
+                    //Start over with an empty cache, bringing back the state being left
+                    const std::string from = m_states[state];
+                    reset();
+                    std::vector<std::uint32_t> fromList(from.size() / sizeof(std::uint32_t));
+                    std::memcpy(fromList.data(), from.data(), from.size());
+                    const bool fromStarts = !fromList.empty() && (fromList.back() == starting);
+                    if(fromStarts)
+                    {
+                        fromList.pop_back();
+                    }
+                    state = add(std::move(fromList), fromStarts);
+                }
+                const std::int32_t target = add(std::move(next), startsThreads);
+                m_transitions[state * m_classCount + byteClass] = target;
+                return target;
+            }
+
+            RegexNfa m_nfa;
+            std::vector<ByteSet> m_sets;
+            bool m_unanchored;
+            std::size_t m_maxStates;
+            std::array<std::uint8_t, 256> m_classes{};
+            std::vector<unsigned char> m_representatives;
+            std::size_t m_classCount = 0;
+            std::array<bool, 256> m_firstBytes{};
+
+            //The key of each state: its groups of NFA states
+            std::vector<std::string> m_states;
+            std::vector<std::uint8_t> m_flags;
+            std::unordered_map<std::string, std::int32_t, StringHash, std::equal_to<>> m_ids;
+            std::vector<std::int32_t> m_transitions;
+            std::int32_t m_start = 0;
+
+            std::vector<std::uint32_t> m_marks;
+            std::uint32_t m_generation = 0;
+            std::vector<std::uint32_t> m_stack;
+        };
+    }
+
+
+    /**
+     * A match of a Regex: where it starts in the string and its length.
+     */
+    struct RegexMatch
+    {
+        std::size_t position;
+        std::size_t length;
+
+        bool operator==( const RegexMatch & ) const = default;
+    };
+
+
+    /**
+     * A compiled regular expression, matched in time linear in the length of the string by lazily built DFAs, with
+     * leftmost-longest (POSIX) semantics: of the matches starting furthest left, the longest.
+     *
+     * The syntax is a subset of ECMAScript's: literal characters, ., [abc], [a-z], [^abc], \d \w \s and their upper case
+     * complements, \n \t \r \f \v \xHH, escaped punctuation, (...) and (?:...) groups without captures, |, *, +, ?,
+     * {n}, {n,} and {n,m} with counts up to 1000, and ^ and $ at the very start and end of the pattern. The anchors
+     * apply to the whole pattern, so a | at its top level has to be put in a group: ^(a|b), not ^a|b. Matching is
+     * byte-wise, so UTF-8 sequences are matched as their bytes.
+     *
+     * The pattern is compiled to a Thompson NFA, from which DFA states are built only as the strings reach them, and
+     * cached up to maxCachedStates before the cache is emptied. A search runs a forward DFA to the end of the
+     * leftmost-longest match, then a DFA of the reversed pattern back to its start. When every match starts with the
+     * same literal characters, the search jumps between their occurrences, found with SSE2, while no match is under way.
+     *
+     * Because the DFA caches are filled while matching, a Regex must not be used from several threads at once; copy it
+     * for each thread instead.
+     *
+     * Throws std::invalid_argument if the pattern is invalid or uses unsupported syntax (backreferences, lookaround,
+     * lazy quantifiers, anchors inside the pattern).
+     */
+    class Regex
+    {
+    public:
+        explicit Regex(     std::string_view pattern,
+                            std::size_t maxCachedStates = 4096  )
+        {
+            detail::RegexParser parser(pattern);
+            const std::uint32_t root = parser.parse();
+            m_anchoredStart = parser.anchoredStart;
+            m_anchoredEnd = parser.anchoredEnd;
+            literalPrefix(parser, root, m_prefix);
+            m_forward.emplace(detail::RegexNfa(parser, root, false), parser.sets, true, maxCachedStates);
+            m_anchored.emplace(detail::RegexNfa(parser, root, false), parser.sets, false, maxCachedStates);
+            m_reverse.emplace(detail::RegexNfa(parser, root, true), parser.sets, false, maxCachedStates);
+        }
+
+        /**
+         * Checks if the whole of a string matches the pattern.
+         */
+        bool matches( std::string_view str ) const
+        {
+            std::int32_t state = m_anchored->start();
+            for(char c : str)
+            {
+                state = m_anchored->next(state, static_cast<unsigned char>(c));
+                if(state == detail::RegexDfa::dead)
+                {
+                    return false;
+                }
+            }
+            return m_anchored->isMatch(state);
+        }
+
+        /**
+         * Finds the leftmost-longest match of the pattern in a string, starting at or after from.
+         *
+         * @param str - The string to search.
+         * @param from - The position to search from.
+         *
+         * @retval std::optional<RegexMatch> - The match, or std::nullopt if there is none.
+         */
+        std::optional<RegexMatch> search(   std::string_view str,
+                                            std::size_t from = 0    ) const
+        {
+            if(from > str.size())
+            {
+                return std::nullopt;
+            }
+            if(m_anchoredStart)
+            {
+                if(from != 0)
+                {
+                    return std::nullopt;
+                }
+                if(m_anchoredEnd)
+                {
+                    return matches(str) ? std::optional<RegexMatch>(RegexMatch{0, str.size()}) : std::nullopt;
+                }
+                const std::size_t end = longestForward(str, 0);
+                return (end != npos) ? std::optional<RegexMatch>(RegexMatch{0, end}) : std::nullopt;
+            }
+
+            std::size_t end = str.size();
+            if(!m_anchoredEnd)
+            {
+                end = leftmostLongestEnd(str, from);
+                if(end == npos)
+                {
+                    return std::nullopt;
+                }
+            }
+            const std::size_t start = longestBackward(str, from, end);
+            if(start == npos)
+            {
+                return std::nullopt;
+            }
+            return RegexMatch{start, end - start};
+        }
+
+        /**
+         * Finds all the non-overlapping leftmost-longest matches of the pattern in a string, like findAll() finds a
+         * substring. After an empty match, the next search starts one character further.
+         */
+        std::vector<RegexMatch> findAll( std::string_view str ) const
+        {
+            std::vector<RegexMatch> found;
+            std::size_t from = 0;
+            while(const std::optional<RegexMatch> match = search(str, from))
+            {
+                found.push_back(*match);
+                from = match->position + std::max<std::size_t>(match->length, 1);
+                if(m_anchoredStart || (from > str.size()))
+                {
+                    break;
+                }
+            }
+            return found;
+        }
+
+    private:
+        static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+        /**
+         * Appends to prefix the literal characters every match of a node starts with, returning true if the node is
+         * made only of them.
+         */
+        static bool literalPrefix(  const detail::RegexParser & parser,
+                                    std::uint32_t node,
+                                    std::string & prefix    )
+        {
+            const detail::RegexNode & current = parser.nodes[node];
+            if(current.kind == detail::RegexNode::Kind::byteSet)
+            {
+                const detail::ByteSet & set = parser.sets[current.set];
+                if(std::popcount(set[0]) + std::popcount(set[1]) + std::popcount(set[2]) + std::popcount(set[3]) != 1)
+                {
+                    return false;
+                }
+                unsigned byte = 0;
+                while(!detail::byteSetContains(set, static_cast<unsigned char>(byte)))
+                {
+                    ++byte;
+                }
+                prefix += static_cast<char>(byte);
+                return true;
+            }
+            if(current.kind == detail::RegexNode::Kind::concatenation)
+            {
+                for(std::uint32_t child : current.children)
+                {
+                    if(!literalPrefix(parser, child, prefix))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+            return current.kind == detail::RegexNode::Kind::empty;
+        }
+
+        /**
+         * The end of the leftmost-longest match starting at or after from, or npos.
+         */
+        std::size_t leftmostLongestEnd(     std::string_view str,
+                                            std::size_t from    ) const
+        {
+            std::size_t end = npos;
+            std::int32_t state = m_forward->start();
+            std::size_t i = from;
+            while(true)
+            {
+                if(m_forward->isMatch(state))
+                {
+                    end = i;
+                }
+                if(state == detail::RegexDfa::dead)
+                {
+                    return end;
+                }
+                //With no thread under way, skip to where the literal prefix occurs next, or else to a byte that can
+                //start a match. A start state that matches the empty string is never left that way.
+                if((state == m_forward->start()) && (end == npos))
+                {
+                    if(!m_prefix.empty())
+                    {
+                        i = detail::findLiteral(str, m_prefix, i);
+                        if(i == std::string_view::npos)
+                        {
+                            return end;
+                        }
+                    }
+                    else
+                    {
+                        while((i < str.size()) && !m_forward->canStart(static_cast<unsigned char>(str[i])))
+                        {
+                            ++i;
+                        }
+                    }
+                }
+                if(i == str.size())
+                {
+                    return end;
+                }
+                do
+                {
+                    state = m_forward->next(state, static_cast<unsigned char>(str[i++]));
+                }
+                while(!m_forward->isSpecial(state) && (i < str.size()));
+            }
+        }
+
+
+        /**
+         * The end of the longest match starting at from, or npos.
+         */
+        std::size_t longestForward(     std::string_view str,
+                                        std::size_t from    ) const
+        {
+            std::size_t end = npos;
+            std::int32_t state = m_anchored->start();
+            for(std::size_t i = from; ; ++i)
+            {
+                if(m_anchored->isMatch(state))
+                {
+                    end = i;
+                }
+                if(i == str.size())
+                {
+                    return end;
+                }
+                state = m_anchored->next(state, static_cast<unsigned char>(str[i]));
+                if(state == detail::RegexDfa::dead)
+                {
+                    return end;
+                }
+            }
+        }
+
+        /**
+         * The smallest start, not before from, of a match ending at end, or npos.
+         */
+        std::size_t longestBackward(    std::string_view str,
+                                        std::size_t from,
+                                        std::size_t end     ) const
+        {
+            std::size_t start = npos;
+            std::int32_t state = m_reverse->start();
+            for(std::size_t i = end; ; --i)
+            {
+                if(m_reverse->isMatch(state))
+                {
+                    start = i;
+                }
+                if(i == from)
+                {
+                    return start;
+                }
+                state = m_reverse->next(state, static_cast<unsigned char>(str[i - 1]));
+                if(state == detail::RegexDfa::dead)
+                {
+                    return start;
+                }
+            }
+        }
+
+        std::string m_prefix;
+        bool m_anchoredStart = false;
+        bool m_anchoredEnd = false;
+        mutable std::optional<detail::RegexDfa> m_forward;
+        mutable std::optional<detail::RegexDfa> m_anchored;
+        mutable std::optional<detail::RegexDfa> m_reverse;
+    };
+
+
     //replace
 
 
@@ -0,0 +1,456 @@
+/**
+ * This is the code for benchmarking stevensStringLib. Each benchmark runs a function over the text of Frankenstein (or
+ * data generated from it) and prints the average time per run along with the throughput.
+ *
+ * Compiles with: g++ -std=c++23 -O2 benchmark.cpp -o benchmark
+ * Run it from the testing folder so that test_string_files/ can be found.
+*/
+#include "../stevensStringLib.h"
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <functional>
+#include <regex>
+
+
+using namespace stevensStringLib;
+
+
+std::string frankenstein_fulltext;
+
+//Accumulates the results of the benchmarked calls, and is printed at the end so that the compiler cannot optimize
+//the calls away
+std::size_t benchmarkSink = 0;
+
+
+/**
+ * Runs a function repeatedly for at least minimumSeconds and prints the average time of a run. When bytesPerRun is
+ * not zero, the throughput is printed too.
+ */
+void benchmark(     const std::string & name,
+                    std::size_t bytesPerRun,
+                    const std::function<void()> & run,
+                    double minimumSeconds = 0.5  )
+{
+    using clock = std::chrono::steady_clock;
+
+    //Warm up the caches and the branch predictors
+    run();
+
+    std::size_t runs = 0;
+    const clock::time_point start = clock::now();
+    double elapsed = 0;
+    do
+    {
+        run();
+        ++runs;
+        elapsed = std::chrono::duration<double>(clock::now() - start).count();
+    }
+    while(elapsed < minimumSeconds);
+
+    const double secondsPerRun = elapsed / runs;
+    std::cout << name << ": " << (secondsPerRun * 1e6) << " us/run";
+    if(bytesPerRun != 0)
+    {
+        std::cout << ", " << (bytesPerRun / secondsPerRun / 1e9) << " GB/s";
+    }
+    std::cout << std::endl;
+}
+
+
+/*** UTF-8 ***/
+void benchmarkUtf8()
+{
+    const std::size_t size = frankenstein_fulltext.size();
+    const unsigned char * data = reinterpret_cast<const unsigned char *>(frankenstein_fulltext.data());
+
+    benchmark("isValidUtf8 (dispatched)", size, [&]() { benchmarkSink += isValidUtf8(frankenstein_fulltext); });
+    benchmark("isValidUtf8 (scalar)", size, [&]() { benchmarkSink += detail::isValidUtf8Scalar(data, size); });
+    benchmark("countCodePoints", size, [&]() { benchmarkSink += countCodePoints(frankenstein_fulltext); });
+    benchmark("utf8ToUtf16", size, [&]() { benchmarkSink += utf8ToUtf16(frankenstein_fulltext).size(); });
+    benchmark("utf8ToUtf32", size, [&]() { benchmarkSink += utf8ToUtf32(frankenstein_fulltext).size(); });
+}
+
+
+/*** Palindromes ***/
+void benchmarkPalindromes()
+{
+    const std::size_t size = frankenstein_fulltext.size();
+
+    benchmark("longestPalindromicSubstring", size, [&]() { benchmarkSink += longestPalindromicSubstring(frankenstein_fulltext).size(); });
+    benchmark("countPalindromicSubstrings", size, [&]() { benchmarkSink += countPalindromicSubstrings(frankenstein_fulltext); });
+}
+
+
+/*** Circular indexing ***/
+void benchmarkCircularIndex()
+{
+    const std::string pattern = "resonance!";
+    std::vector<std::int64_t> indices(1 << 20);
+    for(std::size_t i = 0; i < indices.size(); ++i)
+    {
+        indices[i] = static_cast<std::int64_t>(i * 2654435761u % 100000) - 50000;
+    }
+    std::string out(indices.size(), '\0');
+    const CircularIndexer indexer(pattern);
+
+    benchmark("circularIndex x 1M", 0, [&]() { for(std::int64_t i : indices) { benchmarkSink += circularIndex(pattern, i); } });
+    benchmark("CircularIndexer x 1M", 0, [&]() { for(std::int64_t i : indices) { benchmarkSink += indexer[i]; } });
+    benchmark("CircularIndexer::gather x 1M", 0, [&]() { indexer.gather(indices, out); benchmarkSink += out[7]; });
+}
+
+
+
+/*** Batch integer parsing ***/
+void benchmarkParseIntegerColumn(   const std::string & name,
+                                    unsigned shift,
+                                    bool randomShift    )
+{
+    //A column of 1M integers, as separate() would return them
+    std::vector<std::string> cells(1 << 20);
+    std::size_t bytes = 0;
+    std::uint64_t state = 88172645463325252ULL;
+    for(std::string & cell : cells)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        cell = std::to_string(static_cast<std::int64_t>(state >> (randomShift ? state % 60 : shift)) * ((state & 1) ? -1 : 1));
+        bytes += cell.size();
+    }
+    std::vector<std::int64_t> values(cells.size());
+    std::vector<ParseStatus> statuses(cells.size());
+
+    benchmark("parseIntegers x 1M, " + name, bytes, [&]() { benchmarkSink += parseIntegers(cells, values, statuses) + values[7]; });
+    benchmark("std::from_chars x 1M, " + name, bytes, [&]()
+    {
+        for(std::size_t i = 0; i < cells.size(); ++i)
+        {
+            const std::from_chars_result result = std::from_chars(cells[i].data(), cells[i].data() + cells[i].size(), values[i]);
+            statuses[i] = (result.ec == std::errc()) ? ParseStatus::ok : ParseStatus::invalidCharacter;
+        }
+        benchmarkSink += values[7];
+    });
+}
+
+
+void benchmarkParseIntegers()
+{
+    benchmarkParseIntegerColumn("16-20 digits", 1, false);
+    benchmarkParseIntegerColumn("mixed widths", 0, true);
+}
+
+
+/*** Natural sort ***/
+void benchmarkNaturalSort()
+{
+    //1M file names with numbers of varying widths
+    std::vector<std::string> names(1 << 20);
+    std::uint64_t state = 88172645463325252ULL;
+    for(std::string & name : names)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        name = "img_" + std::to_string(state % 100000) + "_v" + std::to_string((state >> 20) % 12) + ".png";
+    }
+    std::vector<std::string> sorted;
+
+    benchmark("std::sort, lexicographic x 1M", 0, [&]() { sorted = names; std::sort(sorted.begin(), sorted.end()); benchmarkSink += sorted[7].size(); });
+    benchmark("std::sort with NaturalLess x 1M", 0, [&]() { sorted = names; std::sort(sorted.begin(), sorted.end(), NaturalLess()); benchmarkSink += sorted[7].size(); });
+    benchmark("naturalSort (sort keys) x 1M", 0, [&]() { sorted = names; naturalSort(sorted); benchmarkSink += sorted[7].size(); });
+
+    //What natural sorting looked like with eraseNonNumericChars(), on a smaller input since it allocates per comparison
+    std::vector<std::string> fewNames(names.begin(), names.begin() + (1 << 16));
+    benchmark("std::sort with eraseNonNumericChars() x 64K", 0, [&]()
+    {
+        sorted = fewNames;
+        std::sort(sorted.begin(), sorted.end(), [](const std::string & a, const std::string & b)
+        {
+            return std::stoll(eraseNonNumericChars(a)) < std::stoll(eraseNonNumericChars(b));
+        });
+        benchmarkSink += sorted[7].size();
+    });
+    benchmark("std::sort with NaturalLess x 64K", 0, [&]() { sorted = fewNames; std::sort(sorted.begin(), sorted.end(), NaturalLess()); benchmarkSink += sorted[7].size(); });
+}
+
+
+
+/*** String sorting ***/
+void benchmarkSortStrings()
+{
+    //About 2M tokens: the words of Frankenstein, repeated with a numbered suffix so that not all of them are duplicates
+    const std::vector<std::string> words = separate(frankenstein_fulltext, " ");
+    std::vector<std::string> tokens;
+    for(std::size_t copy = 0; copy < 25; ++copy)
+    {
+        for(const std::string & word : words)
+        {
+            tokens.push_back(word + std::to_string(copy));
+        }
+    }
+    std::vector<std::string_view> views(tokens.begin(), tokens.end());
+    std::vector<std::string> sorted;
+    std::vector<std::string_view> sortedViews;
+    const std::string count = std::to_string(tokens.size() / 1000) + "K";
+
+    benchmark("std::sort, std::string x " + count, 0, [&]() { sorted = tokens; std::sort(sorted.begin(), sorted.end()); benchmarkSink += sorted[7].size(); });
+    benchmark("sortStrings, std::string x " + count, 0, [&]() { sorted = tokens; sortStrings(sorted); benchmarkSink += sorted[7].size(); });
+    benchmark("std::sort, std::string_view x " + count, 0, [&]() { sortedViews = views; std::sort(sortedViews.begin(), sortedViews.end()); benchmarkSink += sortedViews[7].size(); });
+    benchmark("sortStrings, std::string_view x " + count, 0, [&]() { sortedViews = views; sortStrings(sortedViews); benchmarkSink += sortedViews[7].size(); });
+    benchmark("sortUnique, std::string x " + count, 0, [&]() { sorted = tokens; benchmarkSink += sortUnique(sorted); });
+}
+
+
+
+/*** Hashing ***/
+void benchmarkHashing()
+{
+    const std::vector<std::string> words = separate(frankenstein_fulltext, " ");
+    std::vector<std::string_view> tokens(words.begin(), words.end());
+    std::size_t bytes = 0;
+    for(std::string_view token : tokens)
+    {
+        bytes += token.size();
+    }
+    std::vector<std::uint64_t> hashes(tokens.size());
+
+    benchmark("std::hash<std::string_view>, corpus tokens", bytes, [&]()
+    {
+        for(std::size_t i = 0; i < tokens.size(); ++i)
+        {
+            hashes[i] = std::hash<std::string_view>()(tokens[i]);
+        }
+        benchmarkSink += hashes[7];
+    });
+    benchmark("hashString, corpus tokens", bytes, [&]()
+    {
+        for(std::size_t i = 0; i < tokens.size(); ++i)
+        {
+            hashes[i] = hashString(tokens[i]);
+        }
+        benchmarkSink += hashes[7];
+    });
+    benchmark("hashStrings, corpus tokens", bytes, [&]() { hashStrings(std::span<const std::string_view>(tokens), std::span<std::uint64_t>(hashes)); benchmarkSink += hashes[7]; });
+    benchmark("std::hash<std::string_view>, whole corpus", frankenstein_fulltext.size(), [&]() { benchmarkSink += std::hash<std::string_view>()(frankenstein_fulltext); });
+    benchmark("hashString, whole corpus", frankenstein_fulltext.size(), [&]() { benchmarkSink += hashString(frankenstein_fulltext); });
+
+    //Counting words the usual way against countTokens()
+    benchmark("separate() + std::unordered_map<std::string, int>", frankenstein_fulltext.size(), [&]()
+    {
+        std::unordered_map<std::string, int> counts;
+        for(const std::string & word : separate(frankenstein_fulltext, " "))
+        {
+            counts[word]++;
+        }
+        benchmarkSink += counts.size();
+    });
+    benchmark("countTokens", frankenstein_fulltext.size(), [&]() { benchmarkSink += countTokens(frankenstein_fulltext, " ").size(); });
+}
+
+
+
+/*** Rolling hashes ***/
+void benchmarkRollingHash()
+{
+    const std::size_t size = frankenstein_fulltext.size();
+
+    benchmark("RollingHash, window 32", size, [&]() { for(const RollingHash::Window & w : RollingHash(frankenstein_fulltext, 32)) { benchmarkSink += w.hash; } });
+    benchmark("findRepeats, k = 32", size, [&]() { benchmarkSink += findRepeats(frankenstein_fulltext, 32).size(); });
+
+    //Patterns of 8 bytes taken from all over the text
+    std::vector<std::string> patternStrings;
+    for(std::size_t i = 0; i < 1000; ++i)
+    {
+        patternStrings.push_back(frankenstein_fulltext.substr(i * 7919 % (size - 8), 8));
+    }
+    std::vector<std::string_view> patterns(patternStrings.begin(), patternStrings.end());
+    benchmark("findAllPatterns, 1000 patterns", size, [&]() { benchmarkSink += findAllPatterns(frankenstein_fulltext, patterns).size(); });
+    benchmark("findAll for each of 1000 patterns", size, [&]()
+    {
+        for(const std::string & pattern : patternStrings)
+        {
+            benchmarkSink += findAll(frankenstein_fulltext, pattern).size();
+        }
+    });
+}
+
+
+
+/*** Suffix array ***/
+void benchmarkSuffixArray()
+{
+    const std::size_t size = frankenstein_fulltext.size();
+    benchmark("SuffixArray build (SA-IS + Kasai)", size, [&]() { benchmarkSink += SuffixArray(frankenstein_fulltext).lcp()[7]; });
+
+    //1000 queries taken from the text, half of them made absent by changing their last character
+    std::vector<std::string> queries;
+    for(std::size_t i = 0; i < 1000; ++i)
+    {
+        queries.push_back(frankenstein_fulltext.substr(i * 7919 % (size - 12), 12));
+        if(i % 2 == 1)
+        {
+            queries.back().back() = '#';
+        }
+    }
+    const SuffixArray index(frankenstein_fulltext);
+    benchmark("SuffixArray::count x 1000", 0, [&]() { for(const std::string & query : queries) { benchmarkSink += index.count(query); } });
+    benchmark("findAll x 1000", 0, [&]() { for(const std::string & query : queries) { benchmarkSink += findAll(frankenstein_fulltext, query).size(); } });
+    benchmark("SuffixArray::contains x 1000", 0, [&]() { for(const std::string & query : queries) { benchmarkSink += index.contains(query); } });
+    benchmark("std::string::find x 1000", 0, [&]() { for(const std::string & query : queries) { benchmarkSink += (frankenstein_fulltext.find(query) != std::string::npos); } });
+    benchmark("SuffixArray::longestRepeatedSubstring", 0, [&]() { benchmarkSink += index.longestRepeatedSubstring().size(); });
+}
+
+
+
+
+void benchmarkFMIndex()
+{
+    const std::size_t size = frankenstein_fulltext.size();
+    benchmark("FMIndex build", size, [&]() { benchmarkSink += FMIndex(frankenstein_fulltext).count("the"); });
+
+    std::vector<std::string> queries;
+    for(std::size_t i = 0; i < 1000; ++i)
+    {
+        queries.push_back(frankenstein_fulltext.substr(i * 7919 % (size - 12), 12));
+        if(i % 2 == 1)
+        {
+            queries.back().back() = '#';
+        }
+    }
+    const FMIndex index(frankenstein_fulltext);
+    benchmark("FMIndex::count x 1000", 0, [&]() { for(const std::string & query : queries) { benchmarkSink += index.count(query); } });
+    benchmark("FMIndex::locate x 1000", 0, [&]() { for(const std::string & query : queries) { benchmarkSink += index.locate(query).size(); } });
+    benchmark("FMIndex::locate(\"the\")", 0, [&]() { benchmarkSink += index.locate("the").size(); });
+}
+
+
+
+
+void benchmarkApproximateSearch()
+{
+    const std::size_t size = frankenstein_fulltext.size();
+    benchmark("findAll(\"Elizabeth\")", size, [&]() { benchmarkSink += findAll(frankenstein_fulltext, "Elizabeth").size(); });
+    for(std::size_t maxDistance : {0, 1, 2})
+    {
+        benchmark("findApproximate(\"Elizabeth\", " + std::to_string(maxDistance) + ")", size, [&]() { benchmarkSink += findApproximate(frankenstein_fulltext, "Elizabeth", maxDistance).size(); });
+    }
+    const std::string longPattern = frankenstein_fulltext.substr(100000, 200);
+    benchmark("findApproximate(200 characters, 2)", size, [&]() { benchmarkSink += findApproximate(frankenstein_fulltext, longPattern, 2).size(); });
+    benchmark("findApproximate(200 characters, 20)", size, [&]() { benchmarkSink += findApproximate(frankenstein_fulltext, longPattern, 20).size(); });
+}
+
+
+
+
+void benchmarkSimilarity()
+{
+    std::vector<std::string> words = separate(frankenstein_fulltext, " ");
+    sortUnique(words);
+    const std::string query = "conversation";
+
+    //The full matrix dynamic programming this replaces
+    const auto naiveLevenshtein = [](const std::string & str1, const std::string & str2)
+    {
+        std::vector<std::vector<std::size_t>> matrix(str1.size() + 1, std::vector<std::size_t>(str2.size() + 1));
+        for(std::size_t i = 0; i <= str1.size(); ++i)
+        {
+            matrix[i][0] = i;
+        }
+        for(std::size_t j = 0; j <= str2.size(); ++j)
+        {
+            matrix[0][j] = j;
+        }
+        for(std::size_t i = 1; i <= str1.size(); ++i)
+        {
+            for(std::size_t j = 1; j <= str2.size(); ++j)
+            {
+                matrix[i][j] = std::min({matrix[i - 1][j] + 1, matrix[i][j - 1] + 1, matrix[i - 1][j - 1] + (str1[i - 1] != str2[j - 1])});
+            }
+        }
+        return matrix[str1.size()][str2.size()];
+    };
+    const std::string label = " x " + std::to_string(words.size()) + " words";
+    benchmark("naive Levenshtein" + label, 0, [&]() { for(const std::string & word : words) { benchmarkSink += naiveLevenshtein(query, word); } });
+    benchmark("levenshteinDistance" + label, 0, [&]() { for(const std::string & word : words) { benchmarkSink += levenshteinDistance(query, word); } });
+    benchmark("LevenshteinMatcher::distance" + label, 0, [&]() { const LevenshteinMatcher matcher(query); for(const std::string & word : words) { benchmarkSink += matcher.distance(word); } });
+    benchmark("findSimilar(2)" + label, 0, [&]() { benchmarkSink += findSimilar(query, words, 2).size(); });
+    benchmark("damerauLevenshteinDistance" + label, 0, [&]() { for(const std::string & word : words) { benchmarkSink += damerauLevenshteinDistance(query, word); } });
+    benchmark("damerauLevenshteinDistance(2)" + label, 0, [&]() { for(const std::string & word : words) { benchmarkSink += damerauLevenshteinDistance(query, word, 2); } });
+    benchmark("jaroWinklerSimilarity" + label, 0, [&]() { for(const std::string & word : words) { benchmarkSink += jaroWinklerSimilarity(query, word) > 0.9; } });
+    benchmark("longestCommonSubsequenceLength" + label, 0, [&]() { for(const std::string & word : words) { benchmarkSink += longestCommonSubsequenceLength(query, word); } });
+}
+
+
+
+
+void benchmarkGlobs()
+{
+    //A routing table of 2000 rules and requests hitting them
+    std::vector<std::string> patterns;
+    std::vector<std::string> requests;
+    for(std::size_t i = 0; i < 1000; ++i)
+    {
+        patterns.push_back("/api/service" + std::to_string(i) + "/*/users/**");
+        patterns.push_back("/static/bundle" + std::to_string(i) + "/**/*.js");
+        requests.push_back("/api/service" + std::to_string(i * 7 % 1000) + "/v2/users/42/profile");
+        requests.push_back("/static/bundle" + std::to_string(i * 13 % 1000) + "/chunks/main.css");
+    }
+    const std::vector<Glob> globs(patterns.begin(), patterns.end());
+    const GlobSet set(patterns);
+    const std::string label = " x " + std::to_string(requests.size()) + " requests, " + std::to_string(patterns.size()) + " patterns";
+    benchmark("Glob::matches, one pattern" + label.substr(0, label.find(',')), 0, [&]() { for(const std::string & request : requests) { benchmarkSink += globs[0].matches(request); } });
+    benchmark("every Glob::matches" + label, 0, [&]() { for(const std::string & request : requests) { for(const Glob & glob : globs) { if(glob.matches(request)) { ++benchmarkSink; break; } } } });
+    benchmark("GlobSet::matches" + label, 0, [&]() { for(const std::string & request : requests) { benchmarkSink += set.matches(request); } });
+}
+
+
+
+
+void benchmarkRegex()
+{
+    const std::size_t size = frankenstein_fulltext.size();
+    for(const char * pattern : {"Frankenstein", "Victor|Elizabeth|Clerval", "[0-9]+", "[A-Z][a-z]+ed", "(?:wh|th)[a-z]*ere"})
+    {
+        const Regex regex(pattern);
+        benchmark(std::string("Regex::findAll(\"") + pattern + "\")", size, [&]() { benchmarkSink += regex.findAll(frankenstein_fulltext).size(); });
+        const std::regex standardRegex(pattern);
+        benchmark(std::string("std::sregex_iterator(\"") + pattern + "\")", size, [&]()
+        {
+            benchmarkSink += std::distance(std::sregex_iterator(frankenstein_fulltext.begin(), frankenstein_fulltext.end(), standardRegex), std::sregex_iterator());
+        });
+    }
+}
+
+
+
+
+int main()
+{
+    //We'll use the text of Frankenstein as a large string to run our functions on
+    std::ifstream input_file("test_string_files/frankenstein.txt");
+    if (!input_file.is_open())
+    {
+        throw std::invalid_argument("Error, could not find test_string_files/frankenstein.txt");
+    }
+    frankenstein_fulltext = std::string((std::istreambuf_iterator<char>(input_file)), std::istreambuf_iterator<char>());
+    input_file.close();
+
+    benchmarkUtf8();
+    benchmarkPalindromes();
+    benchmarkCircularIndex();
+    benchmarkParseIntegers();
+    benchmarkNaturalSort();
+    benchmarkSortStrings();
+    benchmarkHashing();
+    benchmarkRollingHash();
+    benchmarkSuffixArray();
+    benchmarkFMIndex();
+    benchmarkApproximateSearch();
+    benchmarkSimilarity();
+    benchmarkGlobs();
+    benchmarkRegex();
+
+    std::cout << "(checksum: " << benchmarkSink << ")" << std::endl;
+    return 0;
+}
@@ -9,6 +9,7 @@
 #include "../stevensStringLib.h"
 #include <iostream>
 #include <fstream>
+#include <filesystem>
 #include <gtest/gtest.h>
 
 
@@ -296,6 +297,87 @@ TEST(isInteger, check_expression)
     ASSERT_FALSE(result);
 }
 
+TEST(isInteger, check_plus_sign)
+{
+    //Arrange
+    std::string string = "+100";
+    //Act
+    bool result = isInteger(string);
+    //Assert
+    ASSERT_TRUE(result);
+}
+
+TEST(isInteger, check_int64_width)
+{
+    //Arrange
+    std::string string = "3000000000";
+    //Act & Assert
+    EXPECT_FALSE(isInteger(string));
+    EXPECT_TRUE(isInteger<std::int64_t>(string));
+    ASSERT_TRUE(isInteger<std::uint32_t>(string));
+}
+
+TEST(isInteger, check_type_limits)
+{
+    //Arrange
+    //Act & Assert
+    EXPECT_TRUE(isInteger<std::int8_t>("-128"));
+    EXPECT_FALSE(isInteger<std::int8_t>("-129"));
+    EXPECT_TRUE(isInteger<std::int8_t>("127"));
+    EXPECT_FALSE(isInteger<std::int8_t>("128"));
+    EXPECT_TRUE(isInteger<std::uint64_t>("18446744073709551615"));
+    EXPECT_FALSE(isInteger<std::uint64_t>("18446744073709551616"));
+    EXPECT_FALSE(isInteger<unsigned>("-1"));
+    EXPECT_FALSE(isInteger<int>(""));
+    ASSERT_FALSE(isInteger<int>("-"));
+}
+
+TEST(isInteger, check_bases_and_separators)
+{
+    //Arrange
+    //Act & Assert
+    EXPECT_TRUE(isInteger<std::uint32_t>("0xFFFFFFFF", 16));
+    EXPECT_FALSE(isInteger<std::uint32_t>("0x100000000", 16));
+    EXPECT_TRUE(isInteger("-101", 2));
+    EXPECT_FALSE(isInteger("102", 2));
+    EXPECT_TRUE(isInteger("zz", 36));
+    EXPECT_TRUE(isInteger("1'000'000", 10, '\''));
+    EXPECT_FALSE(isInteger("1''000", 10, '\''));
+    EXPECT_FALSE(isInteger("'1000", 10, '\''));
+    ASSERT_FALSE(isInteger("1000'", 10, '\''));
+}
+
+TEST(isInteger, check_invalid_base)
+{
+    //Arrange
+    //Act & Assert
+    EXPECT_THROW(isInteger("1", 1), std::invalid_argument);
+    ASSERT_THROW(isInteger("1", 16, 'a'), std::invalid_argument);
+}
+
+
+/*** parseInteger ***/
+TEST(parseInteger, parse_values)
+{
+    //Arrange
+    //Act & Assert
+    EXPECT_EQ(parseInteger("-2147483648"), std::numeric_limits<int>::min());
+    EXPECT_EQ(parseInteger<std::int64_t>("-9223372036854775808"), std::numeric_limits<std::int64_t>::min());
+    EXPECT_EQ(parseInteger<std::uint16_t>("ff", 16), 255);
+    EXPECT_EQ(parseInteger<long>("1_000_000", 10, '_'), 1000000);
+    ASSERT_FALSE(parseInteger<std::int16_t>("40000").has_value());
+}
+
+template<typename T>
+concept IntegerParsableAs = requires { parseInteger<T>("1"); isInteger<T>("1"); };
+
+TEST(parseInteger, bool_is_not_an_integer_type)
+{
+    //Act & Assert
+    EXPECT_TRUE(IntegerParsableAs<unsigned char>);
+    ASSERT_FALSE(IntegerParsableAs<bool>);
+}
+
 
 /*** isFloat ***/
 TEST(isFloat, check_1point5)
@@ -1106,6 +1188,2308 @@ TEST(isPalindrome, check_non_palindrome)
 }
 
 
+/*** isValidUtf8 ***/
+TEST(isValidUtf8, ascii_and_multibyte)
+{
+    //Arrange
+    std::string string = "Hello, \xC3\xA9t\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80!";
+    //Act
+    bool result = isValidUtf8(string);
+    //Assert
+    ASSERT_TRUE(result);
+}
+
+TEST(isValidUtf8, empty_string)
+{
+    //Arrange
+    std::string string = "";
+    //Act
+    bool result = isValidUtf8(string);
+    //Assert
+    ASSERT_TRUE(result);
+}
+
+TEST(isValidUtf8, invalid_sequences)
+{
+    //Arrange
+    std::vector<std::string> invalidStrings = { "\xC0\xAF",             //Overlong '/'
+                                                "\xE0\x80\xAF",         //Overlong '/'
+                                                "\xED\xA0\x80",         //Surrogate U+D800
+                                                "\xF4\x90\x80\x80",     //Above U+10FFFF
+                                                "\x80",                 //Lone continuation byte
+                                                "abc\xE2\x82",          //Truncated sequence
+                                                "\xFF" };
+    //Act & Assert
+    for(const std::string & string : invalidStrings)
+    {
+        EXPECT_FALSE(isValidUtf8(string)) << "Accepted: " << string;
+        //Same sequences straddling a 32-byte block boundary
+        EXPECT_FALSE(isValidUtf8(std::string(30, 'a') + string + std::string(40, 'b'))) << "Accepted: " << string;
+    }
+}
+
+TEST(isValidUtf8, frankenstein)
+{
+    //Arrange
+        //Using the frankenstein_fulltext string from the global scope, which contains curly quotes and a BOM
+    //Act
+    bool result = isValidUtf8(frankenstein_fulltext);
+    //Assert
+    ASSERT_TRUE(result);
+}
+
+TEST(isValidUtf8, agrees_with_scalar_implementation)
+{
+    //Arrange
+    std::string string = frankenstein_fulltext.substr(0, 2000);
+    const unsigned char replacements[] = {0x80, 0xBF, 0xC2, 0xE0, 0xED, 0xF0, 0xF4, 0xF5};
+    //Act & Assert
+        //Corrupt each position in turn and check that both implementations give the same verdict
+    for(size_t i = 0; i < 200; i++)
+    {
+        for(unsigned char replacement : replacements)
+        {
+            std::string corrupted = string;
+            corrupted[i * 7] = replacement;
+            ASSERT_EQ(isValidUtf8(corrupted), detail::isValidUtf8Scalar(reinterpret_cast<const unsigned char *>(corrupted.data()), corrupted.size()));
+        }
+    }
+}
+
+
+/*** countCodePoints ***/
+TEST(countCodePoints, mixed_widths)
+{
+    //Arrange
+    std::string string = "a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80";
+    //Act
+    size_t result = countCodePoints(string);
+    //Assert
+    ASSERT_EQ(result, 4);
+}
+
+TEST(countCodePoints, frankenstein)
+{
+    //Arrange
+        //Using the frankenstein_fulltext string from the global scope
+    //Act
+    size_t result = countCodePoints(frankenstein_fulltext);
+    //Assert
+    ASSERT_EQ(result, utf8ToUtf32(frankenstein_fulltext).size());
+}
+
+
+/*** utf8ToUtf32 ***/
+TEST(utf8ToUtf32, decode_mixed_widths)
+{
+    //Arrange
+    std::string string = "a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80";
+    //Act
+    std::u32string result = utf8ToUtf32(string);
+    //Assert
+    ASSERT_EQ(result, U"aé€\U0001F600");
+}
+
+TEST(utf8ToUtf32, invalid_input_throws)
+{
+    //Arrange
+    std::string string = "\xC0\xAF";
+    //Act & Assert
+    ASSERT_THROW(utf8ToUtf32(string), std::invalid_argument);
+}
+
+
+/*** utf8ToUtf16 ***/
+TEST(utf8ToUtf16, surrogate_pair)
+{
+    //Arrange
+    std::string string = "x\xF0\x9F\x98\x80";
+    //Act
+    std::u16string result = utf8ToUtf16(string);
+    //Assert
+    ASSERT_EQ(result, u"x\U0001F600");
+    ASSERT_EQ(result.size(), 3);
+}
+
+
+/*** utf16ToUtf8 ***/
+TEST(utf16ToUtf8, round_trip_frankenstein)
+{
+    //Arrange
+        //Using the frankenstein_fulltext string from the global scope
+    //Act
+    std::string result = utf16ToUtf8(utf8ToUtf16(frankenstein_fulltext));
+    //Assert
+    ASSERT_TRUE(result == frankenstein_fulltext);
+}
+
+TEST(utf16ToUtf8, unpaired_surrogate_throws)
+{
+    //Arrange
+    std::u16string string = u"a";
+    string += static_cast<char16_t>(0xD800);
+    //Act & Assert
+    ASSERT_THROW(utf16ToUtf8(string), std::invalid_argument);
+}
+
+
+/*** utf32ToUtf8 ***/
+TEST(utf32ToUtf8, encode_mixed_widths)
+{
+    //Arrange
+    std::u32string string = U"aé€\U0001F600";
+    //Act
+    std::string result = utf32ToUtf8(string);
+    //Assert
+    ASSERT_STREQ(result.c_str(), "a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80");
+}
+
+TEST(utf32ToUtf8, out_of_range_code_point_throws)
+{
+    //Arrange
+    std::u32string string = {0x110000};
+    //Act & Assert
+    ASSERT_THROW(utf32ToUtf8(string), std::invalid_argument);
+}
+
+
+/*** isAscii ***/
+TEST(isAscii, check_frankenstein_prefix)
+{
+    //Arrange
+    std::string string = frankenstein_fulltext.substr(3, 1000);
+    //Act
+    bool result = isAscii(string);
+    //Assert
+    ASSERT_TRUE(result);
+}
+
+TEST(isAscii, check_accented)
+{
+    //Arrange
+    std::string string = std::string(40, 'a') + "\xC3\xA9";
+    //Act
+    bool result = isAscii(string);
+    //Assert
+    ASSERT_FALSE(result);
+}
+
+
+/*** reverseInPlace ***/
+TEST(reverseInPlace, check_hello_world)
+{
+    //Arrange
+    std::string string = "Hello, world!";
+    //Act
+    reverseInPlace(string);
+    //Assert
+    ASSERT_STREQ(string.c_str(), "!dlrow ,olleH");
+}
+
+
+/*** reverseCodePoints ***/
+TEST(reverseCodePoints, check_multibyte)
+{
+    //Arrange
+    std::string string = "a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80";
+    std::string modelResult = "\xF0\x9F\x98\x80\xE2\x82\xAC\xC3\xA9" "a";
+    //Act
+    std::string result = reverseCodePoints(string);
+    //Assert
+    ASSERT_STREQ(result.c_str(), modelResult.c_str());
+}
+
+TEST(reverseCodePoints, invalid_input_throws)
+{
+    //Arrange
+    std::string string = "abc\xE2\x82";
+    //Act & Assert
+    ASSERT_THROW(reverseCodePoints(string), std::invalid_argument);
+}
+
+
+/*** reverseGraphemes ***/
+TEST(reverseGraphemes, combining_accents_stay_attached)
+{
+    //Arrange
+        //"cafe" followed by a combining acute accent, then a space and "noel" with a combining diaeresis on the e
+    std::string string = "cafe\xCC\x81 noe\xCC\x88l";
+    std::string modelResult = "le\xCC\x88on e\xCC\x81" "fac";
+    //Act
+    std::string result = reverseGraphemes(string);
+    //Assert
+    ASSERT_STREQ(result.c_str(), modelResult.c_str());
+}
+
+TEST(reverseGraphemes, emoji_sequences_and_flags)
+{
+    //Arrange
+        //A family emoji made of three code points joined by ZWJ, then the French flag, then CR LF
+    std::string family = "\xF0\x9F\x91\xA8\xE2\x80\x8D\xF0\x9F\x91\xA9\xE2\x80\x8D\xF0\x9F\x91\xA7";
+    std::string flag = "\xF0\x9F\x87\xAB\xF0\x9F\x87\xB7";
+    std::string string = family + "x" + flag + "\r\n";
+    std::string modelResult = "\r\n" + flag + "x" + family;
+    //Act
+    std::string result = reverseGraphemes(string);
+    //Assert
+    ASSERT_EQ(result, modelResult);
+    ASSERT_EQ(countGraphemes(string), 4);
+}
+
+TEST(reverseGraphemes, hangul_leading_consonant_keeps_its_marks)
+{
+    //Arrange
+        //The Hangul leading consonant U+1100 followed by a combining grave accent, then by a ZWJ, then by the vowel U+1161
+    std::string jamo = "\xE1\x84\x80";
+    std::string withAccent = jamo + "\xCC\x80";
+    std::string withZwj = jamo + "\xE2\x80\x8D";
+    std::string syllable = jamo + "\xE1\x85\xA1";
+    std::string string = withAccent + "x" + withZwj;
+    //Act
+    std::string result = reverseGraphemes(string);
+    //Assert
+    EXPECT_EQ(countGraphemes(withAccent), 1);
+    EXPECT_EQ(countGraphemes(withZwj), 1);
+    EXPECT_EQ(countGraphemes(syllable + "\xCC\x80"), 1);
+    ASSERT_EQ(result, withZwj + "x" + withAccent);
+}
+
+TEST(reverseGraphemes, ascii_keeps_crlf)
+{
+    //Arrange
+    std::string string = "ab\r\ncd";
+    //Act
+    reverseGraphemesInPlace(string);
+    //Assert
+    ASSERT_STREQ(string.c_str(), "dc\r\nba");
+}
+
+TEST(reverseGraphemes, empty_string)
+{
+    //Arrange
+    std::string string = "";
+    //Act
+    std::string result = reverseGraphemes(string);
+    //Assert
+    ASSERT_STREQ(result.c_str(), "");
+}
+
+
+/*** isCodePointPalindrome ***/
+TEST(isCodePointPalindrome, check_precomposed_ete)
+{
+    //Arrange
+    std::string string = "\xC3\xA9t\xC3\xA9";
+    //Act
+    bool result = isCodePointPalindrome(string);
+    //Assert
+    EXPECT_FALSE(isPalindrome(string));
+    ASSERT_TRUE(result);
+}
+
+TEST(isCodePointPalindrome, check_non_palindrome)
+{
+    //Arrange
+    std::string string = "\xC3\xA9t\xC3\xA8";
+    //Act
+    bool result = isCodePointPalindrome(string);
+    //Assert
+    ASSERT_FALSE(result);
+}
+
+
+/*** isGraphemePalindrome ***/
+TEST(isGraphemePalindrome, check_decomposed_ete)
+{
+    //Arrange
+    std::string string = "e\xCC\x81te\xCC\x81";
+    //Act
+    bool result = isGraphemePalindrome(string);
+    //Assert
+    EXPECT_FALSE(isCodePointPalindrome(string));
+    ASSERT_TRUE(result);
+}
+
+TEST(isGraphemePalindrome, check_racecar)
+{
+    //Arrange
+    std::string string = "racecar";
+    //Act
+    bool result = isGraphemePalindrome(string);
+    //Assert
+    ASSERT_TRUE(result);
+}
+
+TEST(isGraphemePalindrome, check_non_palindrome)
+{
+    //Arrange
+    std::string string = "e\xCC\x81te";
+    //Act
+    bool result = isGraphemePalindrome(string);
+    //Assert
+    ASSERT_FALSE(result);
+}
+
+
+/*** isPalindrome with a policy ***/
+TEST(isPalindromePolicy, punctuated_english_palindrome)
+{
+    //Arrange
+    std::string string = "A man, a plan, a canal, panama";
+    //Act
+    bool result = isPalindrome(string, PalindromePolicy::ignoreCase | PalindromePolicy::ignoreNonAlphanumeric);
+    //Assert
+    ASSERT_TRUE(result);
+}
+
+TEST(isPalindromePolicy, go_hang_a_salami_needs_case_folding)
+{
+    //Arrange
+    std::string string = "Go hang a salami, I'm a lasagna hog!";
+    //Act
+    bool caseSensitiveResult = isPalindrome(string, PalindromePolicy::ignoreNonAlphanumeric);
+    bool result = isPalindrome(string, PalindromePolicy::ignoreCase | PalindromePolicy::ignoreNonAlphanumeric);
+    //Assert
+    EXPECT_FALSE(caseSensitiveResult);
+    ASSERT_TRUE(result);
+}
+
+TEST(isPalindromePolicy, ignore_case_only)
+{
+    //Arrange
+    std::string string = "RaceCar";
+    //Act
+    bool result = isPalindrome(string, PalindromePolicy::ignoreCase);
+    //Assert
+    EXPECT_FALSE(isPalindrome(string, PalindromePolicy::strict));
+    ASSERT_TRUE(result);
+}
+
+TEST(isPalindromePolicy, only_punctuation)
+{
+    //Arrange
+    std::string string = ",.;! ?";
+    //Act
+    bool result = isPalindrome(string, PalindromePolicy::ignoreNonAlphanumeric);
+    //Assert
+    ASSERT_TRUE(result);
+}
+
+TEST(isPalindromePolicy, strict_long_palindrome)
+{
+    //Arrange
+        //Long enough to go through the 32-byte block comparison, with a mismatch planted in the middle block
+    std::string half = frankenstein_fulltext.substr(1000, 5000);
+    std::string string = half + reverse(half);
+    std::string corrupted = string;
+    corrupted[4990] = '#';
+    //Act
+    bool result = isPalindrome(string, PalindromePolicy::strict);
+    bool corruptedResult = isPalindrome(corrupted, PalindromePolicy::strict);
+    //Assert
+    EXPECT_TRUE(result);
+    ASSERT_FALSE(corruptedResult);
+}
+
+TEST(isPalindromePolicy, strict_all_short_lengths)
+{
+    //Arrange & Act & Assert
+        //Every length around the block size, for a palindrome and for a near miss
+    for(size_t length = 1; length < 150; length++)
+    {
+        std::string string(length, 'x');
+        string[length / 2] = 'y';
+        string[(length - 1) / 2] = 'y';
+        EXPECT_TRUE(isPalindrome(string, PalindromePolicy::strict)) << length;
+        if(length > 1)
+        {
+            string[0] = 'z';
+            EXPECT_FALSE(isPalindrome(string, PalindromePolicy::strict)) << length;
+        }
+    }
+}
+
+
+/*** longestPalindromicSubstring ***/
+TEST(longestPalindromicSubstring, racecar_in_a_sentence)
+{
+    //Arrange
+    std::string string = "I saw a racecar today";
+    //Act
+    std::string_view result = longestPalindromicSubstring(string);
+    //Assert
+    ASSERT_EQ(result, " racecar ");
+}
+
+TEST(longestPalindromicSubstring, even_length)
+{
+    //Arrange
+    std::string string = "cbbd";
+    //Act
+    std::string_view result = longestPalindromicSubstring(string);
+    //Assert
+    ASSERT_EQ(result, "bb");
+}
+
+TEST(longestPalindromicSubstring, leftmost_on_ties)
+{
+    //Arrange
+    std::string string = "abacdc";
+    //Act
+    std::string_view result = longestPalindromicSubstring(string);
+    //Assert
+    ASSERT_EQ(result, "aba");
+}
+
+TEST(longestPalindromicSubstring, empty_string)
+{
+    //Arrange
+    std::string string = "";
+    //Act
+    std::string_view result = longestPalindromicSubstring(string);
+    //Assert
+    ASSERT_TRUE(result.empty());
+}
+
+TEST(longestPalindromicSubstring, frankenstein)
+{
+    //Arrange
+        //Using the frankenstein_fulltext string from the global scope, which is large enough to need 32-bit radii
+    //Act
+    std::string_view result = longestPalindromicSubstring(frankenstein_fulltext);
+    //Assert
+    EXPECT_GE(result.size(), 7);
+    ASSERT_TRUE(isPalindrome(std::string(result)));
+}
+
+
+/*** countPalindromicSubstrings ***/
+TEST(countPalindromicSubstrings, check_aaa)
+{
+    //Arrange
+    std::string string = "aaa";
+    //Act
+    std::uint64_t result = countPalindromicSubstrings(string);
+    //Assert
+    ASSERT_EQ(result, 6);
+}
+
+TEST(countPalindromicSubstrings, agrees_with_naive_count)
+{
+    //Arrange
+    std::string string = frankenstein_fulltext.substr(20000, 1500);
+    std::uint64_t modelResult = 0;
+    for(size_t i = 0; i < string.size(); i++)
+    {
+        for(size_t j = i + 1; j <= string.size(); j++)
+        {
+            modelResult += isPalindrome(string.substr(i, j - i));
+        }
+    }
+    //Act
+    std::uint64_t result = countPalindromicSubstrings(string);
+    //Assert
+    ASSERT_EQ(result, modelResult);
+}
+
+
+/*** findMaximalPalindromes ***/
+TEST(findMaximalPalindromes, abaaba)
+{
+    //Arrange
+    std::string string = "abaaba";
+    std::vector<std::string_view> modelResult = {"aba", "abaaba", "aba"};
+    //Act
+    std::vector<std::string_view> result = findMaximalPalindromes(string, 3);
+    //Assert
+    ASSERT_EQ(result, modelResult);
+}
+
+
+/*** circularIndex with negative indices ***/
+TEST(circularIndex, negative_index)
+{
+    //Arrange
+    std::string string = "resonance!";
+    //Act
+    char last = circularIndex(string, -1);
+    char loopedBack = circularIndex(string, -15);
+    //Assert
+    EXPECT_EQ(last, '!');
+    ASSERT_EQ(loopedBack, 'a');
+}
+
+TEST(circularIndex, empty_string_throws)
+{
+    //Arrange
+    std::string string = "";
+    //Act & Assert
+    ASSERT_THROW(circularIndex(string, 3), std::invalid_argument);
+}
+
+
+/*** CircularIndexer ***/
+TEST(CircularIndexer, agrees_with_circularIndex)
+{
+    //Arrange
+    std::string string = "resonance!";
+    CircularIndexer indexer(string);
+    std::vector<std::int64_t> indices = {0, 9, 10, 105, -1, -10, -11, 4294967295, -4294967295, 4294967296, -4294967296,
+                                         std::numeric_limits<std::int64_t>::max(), std::numeric_limits<std::int64_t>::min()};
+    //Act & Assert
+    for(std::int64_t index : indices)
+    {
+        EXPECT_EQ(indexer[index], circularIndex(string, index)) << index;
+    }
+}
+
+TEST(CircularIndexer, copy_wraps_around)
+{
+    //Arrange
+    std::string string = "abc";
+    CircularIndexer indexer(string);
+    std::string result(8, '\0');
+    //Act
+    indexer.copy(-1, result);
+    //Assert
+    ASSERT_STREQ(result.c_str(), "cabcabca");
+}
+
+TEST(CircularIndexer, empty_string_throws)
+{
+    //Arrange
+    std::string string = "";
+    //Act & Assert
+    ASSERT_THROW(CircularIndexer indexer(string), std::invalid_argument);
+}
+
+
+/*** circularGather ***/
+TEST(circularGather, gather_indices)
+{
+    //Arrange
+    std::string string = "resonance!";
+    std::vector<std::int64_t> indices = {0, 1, 12, -1, 105};
+    //Act
+    std::string result = circularGather(string, indices);
+    //Assert
+    ASSERT_STREQ(result.c_str(), "res!a");
+}
+
+
+/*** CyclicView ***/
+TEST(CyclicView, rotated_reading)
+{
+    //Arrange
+    std::string string = "hello";
+    //Act
+    CyclicView view(string, 2);
+    std::string iterated(view.begin(), view.end());
+    //Assert
+    EXPECT_EQ(view.toString(), "llohe");
+    EXPECT_EQ(iterated, "llohe");
+    ASSERT_EQ(view[4], 'e');
+}
+
+TEST(CyclicView, negative_and_large_rotations)
+{
+    //Arrange
+    std::string string = "hello";
+    //Act
+    CyclicView right(string, -1);
+    CyclicView large(string, 12);
+    //Assert
+    EXPECT_EQ(right.toString(), "ohell");
+    EXPECT_EQ(large.toString(), "llohe");
+    ASSERT_EQ(large.rotated(-2).toString(), "hello");
+}
+
+TEST(CyclicView, comparison_across_pieces)
+{
+    //Arrange
+    std::string a = "cab";
+    std::string b = "bca";
+    //Act
+    CyclicView viewA(a, 1);     //"abc"
+    CyclicView viewB(b, 2);     //"abc"
+    CyclicView viewC(b, 0);     //"bca"
+    //Assert
+    EXPECT_TRUE(viewA == viewB);
+    EXPECT_TRUE(viewA < viewC);
+    ASSERT_TRUE(CyclicView(std::string_view("ab")) < CyclicView(std::string_view("abc")));
+}
+
+
+/*** rotateInPlace ***/
+TEST(rotateInPlace, rotate_left_and_right)
+{
+    //Arrange
+    std::string left = "hello";
+    std::string right = "hello";
+    //Act
+    rotateInPlace(left, 2);
+    rotateInPlace(right, -2);
+    //Assert
+    EXPECT_STREQ(left.c_str(), "llohe");
+    ASSERT_STREQ(right.c_str(), "lohel");
+}
+
+
+/*** minimalRotation ***/
+TEST(minimalRotation, simple_strings)
+{
+    //Arrange & Act & Assert
+    EXPECT_EQ(minimalRotation("bca"), 2);
+    EXPECT_EQ(minimalRotation("abab"), 0);
+    EXPECT_EQ(minimalRotation("baaa"), 1);
+    EXPECT_EQ(minimalRotation(""), 0);
+}
+
+TEST(minimalRotation, agrees_with_brute_force)
+{
+    //Arrange
+    std::vector<std::string> strings = {"dcbadcba", "aabaab", "zzzzy", "abracadabra", "mississippi", "cbacbacba"};
+    //Act & Assert
+    for(const std::string & string : strings)
+    {
+        size_t best = 0;
+        for(size_t r = 1; r < string.size(); r++)
+        {
+            if(CyclicView(string, r) < CyclicView(string, best))
+            {
+                best = r;
+            }
+        }
+        EXPECT_EQ(minimalRotation(string), best) << string;
+    }
+}
+
+
+/*** cyclicFindAll ***/
+TEST(cyclicFindAll, match_wrapping_around)
+{
+    //Arrange
+    std::string string = "abcab";
+    std::vector<size_t> modelResult = {4};
+    //Act
+    std::vector<size_t> result = cyclicFindAll(string, "bab");
+    //Assert
+    ASSERT_EQ(result, modelResult);
+}
+
+TEST(cyclicFindAll, pattern_longer_than_string)
+{
+    //Arrange
+    std::string string = "ab";
+    std::vector<size_t> modelResult = {1};
+    //Act
+    std::vector<size_t> result = cyclicFindAll(string, "baba");
+    //Assert
+    ASSERT_EQ(result, modelResult);
+}
+
+
+/*** isRotation ***/
+TEST(isRotation, waterbottle)
+{
+    //Arrange & Act & Assert
+    EXPECT_TRUE(isRotation("waterbottle", "erbottlewat"));
+    EXPECT_FALSE(isRotation("waterbottle", "erbottlewta"));
+    ASSERT_FALSE(isRotation("abc", "ab"));
+}
+
+
+/*** eraseCharsFromEnd bounds ***/
+TEST(eraseCharsFromEnd, erase_more_than_length)
+{
+    //Arrange
+    std::string string = "abc";
+    //Act
+    std::string result = eraseCharsFromEnd(string, 10);
+    //Assert
+    ASSERT_STREQ(result.c_str(), "");
+}
+
+TEST(eraseCharsFromEnd, erase_negative_count)
+{
+    //Arrange
+    std::string string = "abc";
+    //Act
+    std::string result = eraseCharsFromEnd(string, -2);
+    //Assert
+    ASSERT_STREQ(result.c_str(), "abc");
+}
+
+
+/*** dropFront, dropBack, takeFront, takeBack ***/
+TEST(dropAndTake, clamped_views)
+{
+    //Arrange
+    std::string string = "/usr/local/bin";
+    //Act & Assert
+    EXPECT_EQ(dropFront(string, 4), "/local/bin");
+    EXPECT_EQ(dropBack(string, 4), "/usr/local");
+    EXPECT_EQ(takeFront(string, 4), "/usr");
+    EXPECT_EQ(takeBack(string, 4), "/bin");
+    EXPECT_EQ(dropFront(string, 100), "");
+    EXPECT_EQ(dropBack(string, 100), "");
+    EXPECT_EQ(takeFront(string, 100), string);
+    ASSERT_EQ(takeBack(string, 100), string);
+}
+
+TEST(dropAndTake, views_share_the_buffer)
+{
+    //Arrange
+    std::string string = "Hello, world!";
+    //Act
+    std::string_view result = dropFront(string, 7);
+    //Assert
+    ASSERT_EQ(result.data(), string.data() + 7);
+}
+
+
+/*** dropFrontInPlace, dropBackInPlace ***/
+TEST(dropInPlace, drop_both_ends)
+{
+    //Arrange
+    std::string string = "[payload]";
+    //Act
+    dropFrontInPlace(string, 1);
+    dropBackInPlace(string, 1);
+    //Assert
+    EXPECT_STREQ(string.c_str(), "payload");
+    dropBackInPlace(string, 50);
+    ASSERT_STREQ(string.c_str(), "");
+}
+
+
+/*** Code point aware drop and take ***/
+TEST(dropAndTakeCodePoints, multibyte_characters)
+{
+    //Arrange
+        //"héllo wörld" with precomposed accents
+    std::string string = "h\xC3\xA9llo w\xC3\xB6rld";
+    //Act & Assert
+    EXPECT_EQ(takeFrontCodePoints(string, 2), "h\xC3\xA9");
+    EXPECT_EQ(dropFrontCodePoints(string, 2), "llo w\xC3\xB6rld");
+    EXPECT_EQ(takeBackCodePoints(string, 4), "\xC3\xB6rld");
+    EXPECT_EQ(dropBackCodePoints(string, 4), "h\xC3\xA9llo w");
+    ASSERT_EQ(takeBackCodePoints(string, 100), string);
+}
+
+
+/*** trimView ***/
+TEST(trimView, trim_1_from_hello_world)
+{
+    //Arrange
+    std::string string = "Hello, world!";
+    //Act
+    std::string_view result = trimView(string, 1);
+    //Assert
+    ASSERT_EQ(result, "ello, world");
+}
+
+TEST(trimView, keep_middle_character)
+{
+    //Arrange
+    std::string string = "abc";
+    //Act
+    std::string_view result = trimView(string, 1);
+    //Assert
+    ASSERT_EQ(result, "b");
+}
+
+TEST(trimView, trim_whole_length_of_string)
+{
+    //Arrange
+    std::string string = "How could we wake up with what we know?";
+    //Act
+    std::string_view result = trimView(string, string.length());
+    //Assert
+    ASSERT_TRUE(result.empty());
+}
+
+
+/*** trimWhitespaceView ***/
+TEST(trimWhitespaceView, trim_a_lot_of_whitespace)
+{
+    //Arrange
+    std::string string = " \n\t\r\v\f Hello, world! \n\t\r\v\f";
+    //Act
+    std::string_view result = trimWhitespaceView(string);
+    //Assert
+    ASSERT_EQ(result, "Hello, world!");
+}
+
+TEST(trimWhitespaceView, long_padding)
+{
+    //Arrange
+        //Padding long enough to be skipped in blocks of 16 bytes, on both sides of the blocks
+    for(size_t padding = 0; padding < 40; padding++)
+    {
+        std::string string = std::string(padding, ' ') + "x y" + std::string(padding + 3, '\t');
+        //Act
+        std::string_view result = trimWhitespaceView(string);
+        //Assert
+        ASSERT_EQ(result, "x y") << padding;
+    }
+}
+
+TEST(trimWhitespaceView, only_whitespace)
+{
+    //Arrange
+    std::string string(37, ' ');
+    //Act
+    std::string_view result = trimWhitespaceView(string);
+    //Assert
+    ASSERT_TRUE(result.empty());
+}
+
+
+/*** forEachFixedWidthRecord ***/
+TEST(forEachFixedWidthRecord, parse_three_records)
+{
+    //Arrange
+    std::string data = "0001Alice     Paris     \n"
+                       "0002Bob       London    \n"
+                       "0003   Carol  Rome      ";
+    std::vector<FixedWidthColumn> columns = {   {0, 4, FieldTrim::none},
+                                                {4, 10, FieldTrim::both},
+                                                {14, 10, FieldTrim::trailing}   };
+    std::vector<std::vector<std::string>> result;
+    //Act
+    size_t count = forEachFixedWidthRecord(data, 25, columns, [&](size_t, std::span<const std::string_view> fields)
+    {
+        result.emplace_back(fields.begin(), fields.end());
+    });
+    //Assert
+    std::vector<std::vector<std::string>> modelResult = {   {"0001", "Alice", "Paris"},
+                                                            {"0002", "Bob", "London"},
+                                                            {"0003", "Carol", "Rome"}   };
+    EXPECT_EQ(count, 3);
+    ASSERT_EQ(result, modelResult);
+}
+
+TEST(forEachFixedWidthRecord, column_outside_record_throws)
+{
+    //Arrange
+    std::vector<FixedWidthColumn> columns = {{20, 10}};
+    //Act & Assert
+    ASSERT_THROW(forEachFixedWidthRecord("", 25, columns, [](size_t, std::span<const std::string_view>) {}), std::invalid_argument);
+}
+
+
+/*** MappedFile ***/
+TEST(MappedFile, map_frankenstein)
+{
+    //Arrange
+    std::string filePath = "test_string_files/frankenstein.txt";
+    //Act
+    MappedFile file(filePath);
+    //Assert
+    ASSERT_TRUE(file.view() == frankenstein_fulltext);
+}
+
+TEST(MappedFile, map_empty_file)
+{
+    //Arrange
+    std::string filePath = "test_string_files/emptyFile.txt";
+    //Act
+    MappedFile file(filePath);
+    //Assert
+    ASSERT_EQ(file.size(), 0);
+}
+
+TEST(MappedFile, missing_file_throws)
+{
+    //Arrange
+    std::string filePath = "test_string_files/loonymcfloonyloo.txt";
+    //Act & Assert
+    ASSERT_THROW(MappedFile file(filePath), std::invalid_argument);
+}
+
+
+/*** FixedWidthLayout ***/
+TEST(FixedWidthLayout, column_outside_record_throws)
+{
+    //Arrange
+    std::vector<FixedWidthColumn> columns = {{0, 4}, {4, 30}};
+    //Act & Assert
+    ASSERT_THROW(FixedWidthLayout(columns, 25), std::invalid_argument);
+}
+
+TEST(FixedWidthLayout, read_field)
+{
+    //Arrange
+    FixedWidthLayout layout({{0, 4, FieldTrim::none}, {4, 10}}, 15);
+    std::string data = "0001Alice     \n0002Bob       \n";
+    //Act
+    std::string_view result = layout.field(data, 1, 1);
+    //Assert
+    ASSERT_EQ(result, "Bob");
+}
+
+TEST(FixedWidthLayout, parallel_matches_sequential)
+{
+    //Arrange
+    FixedWidthLayout layout({{0, 8}, {8, 12}}, 21);
+    FixedWidthWriter writer(layout, 10000);
+    for(size_t i = 0; i < 10007; i++)
+    {
+        std::string number = std::to_string(i);
+        writer.writeRecord({number, frankenstein_fulltext.substr(i % 1000, 6)});
+    }
+    std::string data = writer.release();
+    std::vector<std::string> sequential(10007);
+    std::vector<std::string> parallel(10007);
+    //Act
+    layout.forEachRecord(data, [&](size_t record, std::span<const std::string_view> fields)
+    {
+        sequential[record] = std::string(fields[0]) + "|" + std::string(fields[1]);
+    });
+    size_t count = layout.forEachRecordParallel(data, [&](size_t record, std::span<const std::string_view> fields)
+    {
+        parallel[record] = std::string(fields[0]) + "|" + std::string(fields[1]);
+    }, 4);
+    //Assert
+    EXPECT_EQ(count, 10007);
+    EXPECT_EQ(sequential[1234], "1234|" + std::string(trimWhitespaceView(frankenstein_fulltext.substr(234, 6))));
+    ASSERT_EQ(parallel, sequential);
+}
+
+
+/*** FixedWidthWriter ***/
+TEST(FixedWidthWriter, write_aligned_records)
+{
+    //Arrange
+    FixedWidthLayout layout({{0, 6, FieldTrim::both, FieldAlign::left}, {6, 5, FieldTrim::both, FieldAlign::right}}, 12);
+    FixedWidthWriter writer(layout, 1);
+    //Act
+    writer.writeRecord({"apple", "3"});
+    writer.writeRecord({"kiwi", "1200"});
+    //Assert
+    EXPECT_EQ(writer.recordCount(), 2);
+    ASSERT_EQ(writer.view(), "apple     3\nkiwi   1200\n");
+}
+
+TEST(FixedWidthWriter, field_too_wide_throws)
+{
+    //Arrange
+    FixedWidthLayout layout({{0, 3}}, 4);
+    FixedWidthWriter writer(layout);
+    //Act & Assert
+    ASSERT_THROW(writer.writeRecord({"abcd"}), std::invalid_argument);
+}
+
+TEST(FixedWidthWriter, terminator_overlapping_columns_throws)
+{
+    //Arrange
+    FixedWidthLayout layout({{0, 4}}, 4);
+    //Act & Assert
+    ASSERT_THROW(FixedWidthWriter writer(layout), std::invalid_argument);
+}
+
+
+/*** extractNumbers ***/
+TEST(extractNumbers, log_line)
+{
+    //Arrange
+    std::string line = "2024-01-05 request took 12.5ms, -3 retries, x=+7, rate 6.02e23/s";
+    //Act
+    std::vector<ExtractedNumber> result = extractNumbers(line);
+    //Assert
+    std::vector<std::string_view> modelText = {"2024", "01", "05", "12.5", "-3", "+7", "6.02e23"};
+    std::vector<double> modelValue = {2024, 1, 5, 12.5, -3, 7, 6.02e23};
+    ASSERT_EQ(result.size(), modelText.size());
+    for(size_t i = 0; i < result.size(); i++)
+    {
+        EXPECT_EQ(result[i].text, modelText[i]);
+        EXPECT_DOUBLE_EQ(result[i].value, modelValue[i]);
+    }
+    EXPECT_TRUE(result[4].isInteger);
+    EXPECT_FALSE(result[3].isInteger);
+}
+
+TEST(extractNumbers, grouping_and_decimal_comma)
+{
+    //Arrange
+    std::string line = "Total: 1.234.567,89 EUR, 12.3456 items";
+    NumberScanOptions options;
+    options.groupSeparator = '.';
+    options.decimalPoint = ',';
+    //Act
+    std::vector<ExtractedNumber> result = extractNumbers(line, options);
+    //Assert
+    ASSERT_EQ(result.size(), 3);
+    EXPECT_EQ(result[0].text, "1.234.567,89");
+    EXPECT_DOUBLE_EQ(result[0].value, 1234567.89);
+    EXPECT_EQ(result[1].text, "12");
+    EXPECT_EQ(result[2].text, "3456");
+}
+
+TEST(extractNumbers, leading_group_of_four_digits_is_not_grouped)
+{
+    //Arrange
+    std::string line = "1234,567 -1234,567 1,234";
+    NumberScanOptions options;
+    options.groupSeparator = ',';
+    //Act
+    std::vector<ExtractedNumber> result = extractNumbers(line, options);
+    //Assert
+    std::vector<double> modelValues = {1234, 567, -1234, 567, 1234};
+    ASSERT_EQ(result.size(), modelValues.size());
+    for(size_t i = 0; i < result.size(); i++)
+    {
+        EXPECT_EQ(result[i].value, modelValues[i]);
+    }
+}
+
+TEST(extractNumbers, long_grouped_number)
+{
+    //Arrange
+    std::string line = "1";
+    for(int i = 0; i < 100; i++)
+    {
+        line += ",000";
+    }
+    NumberScanOptions options;
+    options.groupSeparator = ',';
+    //Act
+    std::vector<ExtractedNumber> result = extractNumbers(line, options);
+    //Assert
+    ASSERT_EQ(result.size(), 1);
+    ASSERT_DOUBLE_EQ(result[0].value, 1e300);
+}
+
+TEST(extractNumbers, partial_syntax_is_left_out)
+{
+    //Arrange
+    std::string line = "5. 3e .5 v1.2.3 1e999";
+    //Act
+    std::vector<ExtractedNumber> result = extractNumbers(line);
+    //Assert
+    std::vector<std::string_view> modelText = {"5", "3", ".5", "1.2", "3", "1e999"};
+    ASSERT_EQ(result.size(), modelText.size());
+    for(size_t i = 0; i < result.size(); i++)
+    {
+        EXPECT_EQ(result[i].text, modelText[i]);
+    }
+    EXPECT_EQ(result[5].value, std::numeric_limits<double>::infinity());
+}
+
+TEST(extractNumbers, long_digit_runs)
+{
+    //Arrange
+    std::string line = std::string(40, 'x') + "12345678901234567890123" + std::string(33, ' ') + "-42";
+    std::vector<ExtractedNumber> result;
+    //Act
+    extractNumbers(line, result);
+    //Assert
+    ASSERT_EQ(result.size(), 2);
+    EXPECT_EQ(result[0].text, "12345678901234567890123");
+    EXPECT_EQ(result[1].value, -42);
+}
+
+TEST(extractNumbers, signs_disabled)
+{
+    //Arrange
+    std::string line = "-1 +2";
+    NumberScanOptions options;
+    options.allowSign = false;
+    //Act
+    std::vector<ExtractedNumber> result = extractNumbers(line, options);
+    //Assert
+    ASSERT_EQ(result.size(), 2);
+    EXPECT_EQ(result[0].text, "1");
+    EXPECT_EQ(result[1].text, "2");
+}
+
+
+/*** formatInteger ***/
+TEST(formatInteger, matches_to_string)
+{
+    //Arrange
+    std::vector<long long> values = {0, 7, -7, 10, 99, 100, 12345, -1000000, 1234567890123456789LL,
+                                     std::numeric_limits<long long>::max(), std::numeric_limits<long long>::min()};
+    for(long long value : values)
+    {
+        //Act
+        std::string result = formatInteger(value);
+        //Assert
+        ASSERT_EQ(result, std::to_string(value));
+    }
+}
+
+TEST(formatInteger, unsigned_max)
+{
+    //Arrange
+    unsigned long long value = std::numeric_limits<unsigned long long>::max();
+    //Act
+    std::string result = formatInteger(value);
+    //Assert
+    ASSERT_EQ(result, "18446744073709551615");
+}
+
+TEST(formatInteger, grouping)
+{
+    //Arrange
+    //Act & Assert
+    EXPECT_EQ(formatInteger(123, ','), "123");
+    EXPECT_EQ(formatInteger(1234, ','), "1,234");
+    EXPECT_EQ(formatInteger(-1234567, ','), "-1,234,567");
+    EXPECT_EQ(formatInteger(1234567890, ','), "1,234,567,890");
+    EXPECT_EQ(formatInteger(std::numeric_limits<unsigned long long>::max(), ','), "18,446,744,073,709,551,615");
+    ASSERT_EQ(formatInteger(std::numeric_limits<long long>::min(), '\''), "-9'223'372'036'854'775'808");
+}
+
+TEST(formatInteger, grouping_matches_to_string)
+{
+    //Arrange
+    for(long long value = 1; value < std::numeric_limits<long long>::max() / 7; value = value * 7 + 3)
+    {
+        std::string modelResult = std::to_string(value);
+        for(std::size_t i = modelResult.size(); i > 3; i -= 3)
+        {
+            modelResult.insert(i - 3, 1, ',');
+        }
+        //Act
+        std::string result = formatInteger(value, ',');
+        //Assert
+        ASSERT_EQ(result, modelResult);
+    }
+}
+
+TEST(formatInteger, buffer_too_small_throws)
+{
+    //Arrange
+    char buffer[4];
+    //Act & Assert
+    ASSERT_THROW(formatInteger(12345, std::span<char>(buffer)), std::invalid_argument);
+}
+
+
+/*** formatFloat ***/
+TEST(formatFloat, shortest_round_trip)
+{
+    //Arrange
+    //Act & Assert
+    EXPECT_EQ(formatFloat(0.1), "0.1");
+    EXPECT_EQ(formatFloat(-2.5), "-2.5");
+    ASSERT_EQ(formatFloat(1e20), "1e+20");
+}
+
+TEST(formatFloat, fixed_precision_and_grouping)
+{
+    //Arrange
+    //Act & Assert
+    EXPECT_EQ(formatFloat(1234567.891, 2), "1234567.89");
+    EXPECT_EQ(formatFloat(1234567.891, 2, ','), "1,234,567.89");
+    ASSERT_EQ(formatFloat(-1e300, 0, ',').size(), 1 + 301 + 100);
+}
+
+
+/*** formatIntegers ***/
+TEST(formatIntegers, format_column)
+{
+    //Arrange
+    std::vector<int> values = {1, -20, 3000, 0};
+    //Act
+    FormattedColumn result = formatIntegers(std::span<const int>(values), ',');
+    //Assert
+    EXPECT_EQ(result.buffer, "1-203,0000");
+    EXPECT_EQ(result.size(), 4);
+    ASSERT_EQ(result[2], "3,000");
+}
+
+
+/*** formatFloats ***/
+TEST(formatFloats, format_column)
+{
+    //Arrange
+    std::vector<double> values = {0.5, 1e300, -3.25};
+    //Act
+    FormattedColumn result = formatFloats(values, 1);
+    //Assert
+    ASSERT_EQ(result.size(), 3);
+    EXPECT_EQ(result[0], "0.5");
+    EXPECT_EQ(result[1].size(), 303);
+    ASSERT_EQ(result[2], "-3.2");
+}
+
+
+/*** parseIntegers ***/
+TEST(parseIntegers, parse_column_with_errors)
+{
+    //Arrange
+    std::vector<std::string> cells = {"0", "-7", "+42", "12345678", "123456789", "-9223372036854775808",
+                                      "9223372036854775807", "9223372036854775808", "", "12a4", "-", "000000000000000000000042",
+                                      "100000000000000000000"};
+    std::vector<std::int64_t> values;
+    std::vector<ParseStatus> statuses;
+    //Act
+    size_t failures = parseIntegers(cells, values, statuses);
+    //Assert
+    std::vector<std::int64_t> modelValues = {0, -7, 42, 12345678, 123456789, std::numeric_limits<std::int64_t>::min(),
+                                             std::numeric_limits<std::int64_t>::max(), 0, 0, 0, 0, 42, 0};
+    std::vector<ParseStatus> modelStatuses = {ParseStatus::ok, ParseStatus::ok, ParseStatus::ok, ParseStatus::ok, ParseStatus::ok,
+                                              ParseStatus::ok, ParseStatus::ok, ParseStatus::outOfRange, ParseStatus::empty,
+                                              ParseStatus::invalidCharacter, ParseStatus::invalidCharacter, ParseStatus::ok,
+                                              ParseStatus::outOfRange};
+    EXPECT_EQ(failures, 5);
+    EXPECT_EQ(values, modelValues);
+    ASSERT_EQ(statuses, modelStatuses);
+}
+
+TEST(parseIntegers, matches_from_chars)
+{
+    //Arrange
+    std::vector<std::string> cells;
+    for(std::int64_t value = 1; value < std::numeric_limits<std::int64_t>::max() / 3; value = value * 3 + 1)
+    {
+        cells.push_back(std::to_string(value));
+        cells.push_back(std::to_string(-value));
+    }
+    std::vector<std::int64_t> values;
+    std::vector<ParseStatus> statuses;
+    //Act
+    size_t failures = parseIntegers(cells, values, statuses);
+    //Assert
+    ASSERT_EQ(failures, 0);
+    for(size_t i = 0; i < cells.size(); i++)
+    {
+        std::int64_t modelValue = 0;
+        std::from_chars(cells[i].data(), cells[i].data() + cells[i].size(), modelValue);
+        ASSERT_EQ(values[i], modelValue) << cells[i];
+    }
+}
+
+TEST(parseIntegers, size_mismatch_throws)
+{
+    //Arrange
+    std::vector<std::string_view> cells = {"1", "2"};
+    std::vector<std::int64_t> values(1);
+    std::vector<ParseStatus> statuses(2);
+    //Act & Assert
+    ASSERT_THROW(parseIntegers(std::span<const std::string_view>(cells), std::span<std::int64_t>(values), std::span<ParseStatus>(statuses)), std::invalid_argument);
+}
+
+
+/*** isDecimalString ***/
+TEST(isDecimalString, check_long_numbers)
+{
+    //Arrange
+    //Act & Assert
+    EXPECT_TRUE(isDecimalString("123456789012345678901234567890"));
+    EXPECT_TRUE(isDecimalString("-0.000000000000000000000000000001"));
+    EXPECT_TRUE(isDecimalString("+42"));
+    EXPECT_FALSE(isDecimalString("1.5", false));
+    EXPECT_FALSE(isDecimalString(""));
+    EXPECT_FALSE(isDecimalString("-"));
+    EXPECT_FALSE(isDecimalString("1."));
+    EXPECT_FALSE(isDecimalString(".5"));
+    ASSERT_FALSE(isDecimalString("12345678901234567890x"));
+}
+
+
+/*** compareNumericStrings ***/
+TEST(compareNumericStrings, compare_values)
+{
+    //Arrange
+    //Act & Assert
+    EXPECT_EQ(compareNumericStrings("007.50", "7.5"), std::strong_ordering::equal);
+    EXPECT_EQ(compareNumericStrings("-0", "0.000"), std::strong_ordering::equal);
+    EXPECT_EQ(compareNumericStrings("99999999999999999999", "100000000000000000000"), std::strong_ordering::less);
+    EXPECT_EQ(compareNumericStrings("1.0001", "1.00009"), std::strong_ordering::greater);
+    EXPECT_EQ(compareNumericStrings("-2", "-10"), std::strong_ordering::greater);
+    EXPECT_EQ(compareNumericStrings("-1", "1"), std::strong_ordering::less);
+    ASSERT_THROW(compareNumericStrings("1", "one"), std::invalid_argument);
+}
+
+
+/*** BigDecimal ***/
+TEST(BigDecimal, round_trip)
+{
+    //Arrange
+    std::vector<std::string> strings = {"0", "-1", "123456789012345678901234567890", "0.05", "-1000000000.000000001", "1.50"};
+    for(const std::string & string : strings)
+    {
+        //Act
+        BigDecimal result(string);
+        //Assert
+        ASSERT_EQ(result.toString(), string);
+    }
+}
+
+TEST(BigDecimal, add_and_subtract)
+{
+    //Arrange
+    BigDecimal a("999999999999999999999999999999.99");
+    BigDecimal b("0.01");
+    //Act & Assert
+    EXPECT_EQ((a + b).toString(), "1000000000000000000000000000000.00");
+    EXPECT_EQ((b - a).toString(), "-999999999999999999999999999999.98");
+    EXPECT_EQ((BigDecimal("1.50") + BigDecimal("0.2")).toString(), "1.70");
+    ASSERT_EQ((BigDecimal("-3.5") + BigDecimal("3.5")).toString(), "0.0");
+}
+
+TEST(BigDecimal, compare)
+{
+    //Arrange
+    //Act & Assert
+    EXPECT_EQ(BigDecimal("1.5"), BigDecimal("1.500"));
+    EXPECT_LT(BigDecimal("-12345678901234567890"), BigDecimal("-1234567890123456789"));
+    EXPECT_GT(BigDecimal("0.1"), BigDecimal("0.09999999999999999999"));
+    ASSERT_THROW(BigDecimal("1e5"), std::invalid_argument);
+}
+
+
+/*** naturalCompare ***/
+TEST(naturalCompare, compare_file_names)
+{
+    //Arrange
+    //Act & Assert
+    EXPECT_EQ(naturalCompare("file9", "file10"), std::strong_ordering::less);
+    EXPECT_EQ(naturalCompare("file10", "file9"), std::strong_ordering::greater);
+    EXPECT_EQ(naturalCompare("v1.10.2", "v1.9.12"), std::strong_ordering::greater);
+    EXPECT_EQ(naturalCompare("a", "a1"), std::strong_ordering::less);
+    EXPECT_EQ(naturalCompare("a01", "a1"), std::strong_ordering::less);
+    EXPECT_EQ(naturalCompare("a1", "a1"), std::strong_ordering::equal);
+    EXPECT_EQ(naturalCompare("123456789012345678901234567890", "99999999999999999999999999999"), std::strong_ordering::greater);
+    EXPECT_EQ(naturalCompare("File2", "file10", true), std::strong_ordering::less);
+    ASSERT_EQ(naturalCompare("File2", "file10"), std::strong_ordering::less);
+}
+
+
+/*** naturalSortKey ***/
+TEST(naturalSortKey, keys_order_like_naturalCompare)
+{
+    //Arrange
+    std::vector<std::string> strings = {"file10", "file9", "file09", "File1", "file", "file1a", "file1", "x", "",
+                                        "a0b", "a00b", "a b", std::string("a\0b", 3), std::string("a\1b", 3), "img12.png",
+                                        "img2.png", "img2.jpg", "2", "10", "abc", "ABC"};
+    for(bool ignoreCase : {false, true})
+    {
+        for(const std::string & a : strings)
+        {
+            for(const std::string & b : strings)
+            {
+                //Act
+                std::strong_ordering keyOrder = naturalSortKey(a, ignoreCase) <=> naturalSortKey(b, ignoreCase);
+                //Assert
+                ASSERT_EQ(keyOrder, naturalCompare(a, b, ignoreCase)) << a << " vs " << b;
+            }
+        }
+    }
+}
+
+
+/*** naturalSort ***/
+TEST(naturalSort, sort_file_names)
+{
+    //Arrange
+    std::vector<std::string> strings = {"file10.txt", "file2.txt", "file1.txt", "file20.txt", "file3.txt"};
+    //Act
+    naturalSort(strings);
+    //Assert
+    std::vector<std::string> modelResult = {"file1.txt", "file2.txt", "file3.txt", "file10.txt", "file20.txt"};
+    ASSERT_EQ(strings, modelResult);
+}
+
+TEST(naturalSort, matches_sort_with_NaturalLess)
+{
+    //Arrange
+    std::vector<std::string> strings = separate(frankenstein_fulltext.substr(0, 20000), " ");
+    for(size_t i = 0; i < strings.size(); i++)
+    {
+        strings[i] += std::to_string(i * 7919 % 1000);
+    }
+    std::vector<std::string> modelResult = strings;
+    std::sort(modelResult.begin(), modelResult.end(), NaturalLess{true});
+    //Act
+    naturalSort(strings, true);
+    //Assert
+    ASSERT_EQ(strings, modelResult);
+}
+
+
+/*** sortStrings ***/
+TEST(sortStrings, matches_std_sort)
+{
+    //Arrange
+    std::vector<std::string> strings = separate(frankenstein_fulltext, " ");
+    //Strings that only differ past their first 8 bytes, by length, or by embedded zeros
+    strings.insert(strings.end(), {"", "", "abcdefgh", "abcdefghi", "abcdefgh", std::string("ab\0", 3), "ab",
+                                   std::string("ab\0\0\0\0\0\0\0", 9), "abcdefghijklmnopq", "abcdefghijklmnopp"});
+    std::vector<std::string> modelResult = strings;
+    std::sort(modelResult.begin(), modelResult.end());
+    //Act
+    sortStrings(strings, 4);
+    //Assert
+    ASSERT_EQ(strings, modelResult);
+}
+
+TEST(sortStrings, median_of_three_killer_matches_std_sort)
+{
+    //Arrange
+        //McIlroy's adversary: replay the partitioning, giving entries their values only when they become pivot
+        //candidates. Entries without one compare greater than all the others, so every partition splits off almost
+        //nothing and only the recursion budget stops the sort from going thousands of levels deep.
+    const std::size_t count = 5000;
+    const std::size_t unset = count;
+    std::vector<std::size_t> value(count, unset);
+    std::vector<std::size_t> order(count);
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        order[i] = i;
+    }
+    std::size_t nextValue = 0;
+    std::size_t first = 0;
+    std::size_t size = count;
+    while(size > 16)
+    {
+        for(std::size_t candidate : {first, first + size / 2, first + size - 1})
+        {
+            if(value[order[candidate]] == unset)
+            {
+                value[order[candidate]] = nextValue++;
+            }
+        }
+        const std::size_t a = value[order[first]];
+        const std::size_t b = value[order[first + size / 2]];
+        const std::size_t c = value[order[first + size - 1]];
+        const std::size_t pivot = std::max(std::min(a, b), std::min(std::max(a, b), c));
+        std::size_t less = 0;
+        std::size_t i = 0;
+        std::size_t greater = size;
+        while(i < greater)
+        {
+            const std::size_t v = value[order[first + i]];
+            if(v < pivot)
+            {
+                std::swap(order[first + less++], order[first + i++]);
+            }
+            else if(v > pivot)
+            {
+                std::swap(order[first + i], order[first + --greater]);
+            }
+            else
+            {
+                ++i;
+            }
+        }
+        first += greater;
+        size -= greater;
+    }
+    std::vector<std::string> strings;
+    for(std::size_t & v : value)
+    {
+        if(v == unset)
+        {
+            v = nextValue++;
+        }
+        std::string digits = std::to_string(v);
+        strings.push_back(std::string(8 - digits.size(), '0') + digits);
+    }
+    std::vector<std::string> modelResult = strings;
+    std::sort(modelResult.begin(), modelResult.end());
+    //Act
+    sortStrings(strings, 1);
+    //Assert
+    ASSERT_EQ(strings, modelResult);
+}
+
+TEST(sortStrings, sort_views_single_thread)
+{
+    //Arrange
+    std::vector<std::string_view> strings = {"pear", "apple", "fig", "apples", "", "banana"};
+    //Act
+    sortStrings(strings, 1);
+    //Assert
+    std::vector<std::string_view> modelResult = {"", "apple", "apples", "banana", "fig", "pear"};
+    ASSERT_EQ(strings, modelResult);
+}
+
+
+/*** sortUnique ***/
+TEST(sortUnique, deduplicate_words)
+{
+    //Arrange
+    std::vector<std::string> strings = separate(frankenstein_fulltext, " ");
+    std::set<std::string> modelResult(strings.begin(), strings.end());
+    //Act
+    size_t count = sortUnique(strings);
+    //Assert
+    EXPECT_EQ(count, modelResult.size());
+    ASSERT_TRUE(std::equal(strings.begin(), strings.end(), modelResult.begin(), modelResult.end()));
+}
+
+
+/*** countTokens ***/
+TEST(countTokens, count_words)
+{
+    //Arrange
+    std::string text = "the cat  and the hat\tand the bat\n";
+    //Act
+    TokenFrequencyTable result = countTokens(text);
+    //Assert
+    EXPECT_EQ(result.count("the"), 3);
+    EXPECT_EQ(result.count("and"), 2);
+    EXPECT_EQ(result.count("cat"), 1);
+    EXPECT_EQ(result.count("dog"), 0);
+    EXPECT_EQ(result.size(), 5);
+    ASSERT_EQ(result.totalCount(), 8);
+}
+
+TEST(countTokens, matches_separate_and_unordered_map)
+{
+    //Arrange
+    std::unordered_map<std::string, size_t> modelResult;
+    for(const std::string & word : separate(frankenstein_fulltext, " "))
+    {
+        if(!word.empty())
+        {
+            modelResult[word]++;
+        }
+    }
+    //Act
+    TokenFrequencyTable result = countTokens(frankenstein_fulltext, " ");
+    //Assert
+    ASSERT_EQ(result.size(), modelResult.size());
+    for(const auto & [word, count] : modelResult)
+    {
+        ASSERT_EQ(result.count(word), count) << word;
+    }
+}
+
+TEST(countTokens, parallel_matches_sequential)
+{
+    //Arrange
+    TokenFrequencyTable sequential = countTokens(frankenstein_fulltext);
+    //Act
+    TokenFrequencyTable parallel = countTokens(frankenstein_fulltext, " \t\n\r\v\f", 4);
+    //Assert
+    EXPECT_EQ(parallel.size(), sequential.size());
+    EXPECT_EQ(parallel.totalCount(), sequential.totalCount());
+    sequential.forEach([&](std::string_view token, size_t count)
+    {
+        ASSERT_EQ(parallel.count(token), count) << token;
+    });
+}
+
+
+/*** TokenFrequencyTable ***/
+TEST(TokenFrequencyTable, top_k)
+{
+    //Arrange
+    TokenFrequencyTable table;
+    table.add("b", 5);
+    table.add("a", 5);
+    table.add("c", 9);
+    table.add("d", 1);
+    //Act
+    std::vector<std::pair<std::string_view, size_t>> result = table.topK(3);
+    //Assert
+    std::vector<std::pair<std::string_view, size_t>> modelResult = {{"c", 9}, {"a", 5}, {"b", 5}};
+    EXPECT_EQ(result, modelResult);
+    ASSERT_EQ(table.topK(10).size(), 4);
+}
+
+TEST(TokenFrequencyTable, top_k_matches_sort)
+{
+    //Arrange
+    TokenFrequencyTable table = countTokens(frankenstein_fulltext);
+    std::vector<std::pair<std::string_view, size_t>> modelResult;
+    table.forEach([&](std::string_view token, size_t count) { modelResult.emplace_back(token, count); });
+    std::sort(modelResult.begin(), modelResult.end(), [](const auto & a, const auto & b)
+    {
+        return (a.second > b.second) || ((a.second == b.second) && (a.first < b.first));
+    });
+    modelResult.resize(50);
+    //Act
+    std::vector<std::pair<std::string_view, size_t>> result = table.topK(50);
+    //Assert
+    EXPECT_EQ(result[0].first, "the");
+    ASSERT_EQ(result, modelResult);
+}
+
+
+/*** hashString ***/
+TEST(hashString, wyhash_test_vectors)
+{
+    //Arrange
+    std::vector<std::string> strings = {"", "a", "abc", "message digest", "abcdefghijklmnopqrstuvwxyz",
+                                        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789",
+                                        "12345678901234567890123456789012345678901234567890123456789012345678901234567890"};
+    std::vector<std::uint64_t> modelResult = {0x93228a4de0eec5a2, 0xc5bac3db178713c4, 0xa97f2f7b1d9b3314, 0x786d1f1df3801df4,
+                                              0xdca5a8138ad37c87, 0xb9e734f117cfaf70, 0x6cc5eab49a92d617};
+    for(size_t i = 0; i < strings.size(); i++)
+    {
+        //Act
+        std::uint64_t result = hashString(strings[i], i);
+        //Assert
+        ASSERT_EQ(result, modelResult[i]) << strings[i];
+    }
+}
+
+TEST(hashString, no_collisions_on_corpus_words)
+{
+    //Arrange
+    TokenFrequencyTable words = countTokens(frankenstein_fulltext);
+    std::set<std::uint64_t> hashes;
+    //Act
+    words.forEach([&](std::string_view word, size_t) { hashes.insert(hashString(word)); });
+    //Assert
+    ASSERT_EQ(hashes.size(), words.size());
+}
+
+
+/*** hashStrings ***/
+TEST(hashStrings, matches_hashString)
+{
+    //Arrange
+    std::vector<std::string> strings = separate(frankenstein_fulltext.substr(0, 5000), " ");
+    //Act
+    std::vector<std::uint64_t> result = hashStrings(strings, 42);
+    //Assert
+    ASSERT_EQ(result.size(), strings.size());
+    for(size_t i = 0; i < strings.size(); i++)
+    {
+        ASSERT_EQ(result[i], hashString(strings[i], 42));
+    }
+}
+
+
+/*** StringHash ***/
+TEST(StringHash, heterogeneous_lookup)
+{
+    //Arrange
+    std::unordered_map<std::string, int, StringHash, std::equal_to<>> counts = {{"apple", 1}, {"pear", 2}};
+    std::string_view key = "pear";
+    //Act
+    auto result = counts.find(key);
+    //Assert
+    ASSERT_NE(result, counts.end());
+    EXPECT_EQ(result->second, 2);
+    ASSERT_EQ(StringHash()("apple"), StringHash()(std::string("apple")));
+}
+
+
+/*** RollingHash ***/
+TEST(RollingHash, rolled_hashes_match_direct_hashes)
+{
+    //Arrange
+    std::string text = frankenstein_fulltext.substr(0, 3000);
+    RollingHash hashes(text, 13);
+    size_t count = 0;
+    //Act & Assert
+    for(const RollingHash::Window & window : hashes)
+    {
+        ASSERT_EQ(window.position, count);
+        ASSERT_EQ(window.hash, hashes.hashOf(text.substr(window.position, 13)));
+        count++;
+    }
+    ASSERT_EQ(count, text.size() - 12);
+}
+
+TEST(RollingHash, text_shorter_than_window)
+{
+    //Arrange
+    RollingHash hashes("abc", 4);
+    //Act & Assert
+    EXPECT_EQ(hashes.size(), 0);
+    EXPECT_TRUE(hashes.begin() == hashes.end());
+    ASSERT_THROW(RollingHash("abc", 0), std::invalid_argument);
+}
+
+
+/*** findRepeats ***/
+TEST(findRepeats, find_repeated_words)
+{
+    //Arrange
+    std::string text = "the cat sat on the mat";
+    //Act
+    std::vector<Repeat> result = findRepeats(text, 4);
+    //Assert
+    ASSERT_EQ(result.size(), 1);
+    EXPECT_EQ(result[0].position, 15);
+    ASSERT_EQ(result[0].firstPosition, 0);
+}
+
+TEST(findRepeats, matches_naive_search)
+{
+    //Arrange
+    std::string text = frankenstein_fulltext.substr(0, 20000);
+    //Act
+    std::vector<Repeat> result = findRepeats(text, 12);
+    //Assert
+    std::unordered_map<std::string_view, size_t> first;
+    std::vector<std::pair<size_t, size_t>> modelResult;
+    for(size_t i = 0; i + 12 <= text.size(); i++)
+    {
+        auto [it, inserted] = first.emplace(std::string_view(text).substr(i, 12), i);
+        if(!inserted)
+        {
+            modelResult.emplace_back(i, it->second);
+        }
+    }
+    ASSERT_EQ(result.size(), modelResult.size());
+    for(size_t i = 0; i < result.size(); i++)
+    {
+        ASSERT_EQ(result[i].position, modelResult[i].first);
+        ASSERT_EQ(result[i].firstPosition, modelResult[i].second);
+    }
+}
+
+
+/*** findAllPatterns ***/
+TEST(findAllPatterns, matches_findAll)
+{
+    //Arrange
+    std::vector<std::string_view> patterns = {"Victor", "Elizab", "monste", "ice an", "Victor", "zzzzzz"};
+    //Act
+    std::vector<PatternMatch> result = findAllPatterns(frankenstein_fulltext, patterns);
+    //Assert
+    for(size_t p = 0; p < patterns.size(); p++)
+    {
+        std::vector<size_t> modelPositions = findAll(frankenstein_fulltext, std::string(patterns[p]));
+        std::vector<size_t> positions;
+        for(const PatternMatch & match : result)
+        {
+            if(match.pattern == p)
+            {
+                positions.push_back(match.position);
+            }
+        }
+        ASSERT_EQ(positions, modelPositions) << patterns[p];
+    }
+    ASSERT_TRUE(std::is_sorted(result.begin(), result.end(), [](const PatternMatch & a, const PatternMatch & b)
+    {
+        return (a.position < b.position) || ((a.position == b.position) && (a.pattern < b.pattern));
+    }));
+}
+
+TEST(findAllPatterns, different_lengths_throw)
+{
+    //Arrange
+    std::vector<std::string_view> patterns = {"abc", "de"};
+    //Act & Assert
+    ASSERT_THROW(findAllPatterns("abcde", patterns), std::invalid_argument);
+}
+
+
+/*** SuffixArray ***/
+TEST(SuffixArray, banana)
+{
+    //Arrange
+    std::string text = "banana";
+    //Act
+    SuffixArray index(text);
+    //Assert
+    std::vector<std::int32_t> modelSuffixes = {5, 3, 1, 0, 4, 2};
+    std::vector<std::int32_t> modelLcp = {1, 3, 0, 0, 2};
+    EXPECT_TRUE(std::ranges::equal(index.suffixes(), modelSuffixes));
+    EXPECT_TRUE(std::ranges::equal(index.lcp(), modelLcp));
+    ASSERT_EQ(index.longestRepeatedSubstring(), "ana");
+}
+
+TEST(SuffixArray, matches_naive_sort)
+{
+    //Arrange
+    std::uint64_t state = 12345;
+    for(size_t length = 0; length < 300; length++)
+    {
+        std::string text(length, 'a');
+        for(char & c : text)
+        {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            //Small alphabets give many repeats, and so deep recursions
+            c = static_cast<char>('a' + (state >> 33) % (1 + length % 4));
+        }
+        std::vector<std::int64_t> modelSuffixes(length);
+        for(size_t i = 0; i < length; i++)
+        {
+            modelSuffixes[i] = i;
+        }
+        std::sort(modelSuffixes.begin(), modelSuffixes.end(), [&](std::int64_t a, std::int64_t b)
+        {
+            return std::string_view(text).substr(a) < std::string_view(text).substr(b);
+        });
+        //Act
+        SuffixArray<std::int64_t> index(text);
+        //Assert
+        ASSERT_TRUE(std::ranges::equal(index.suffixes(), modelSuffixes)) << text;
+    }
+}
+
+TEST(SuffixArray, queries_match_findAll)
+{
+    //Arrange
+    SuffixArray index(frankenstein_fulltext);
+    std::vector<std::string> patterns = {"Victor", "the", "Elizabeth", "monster", "zzz", "e", "\n\n"};
+    for(const std::string & pattern : patterns)
+    {
+        //Act
+        std::vector<size_t> result = index.findAll(pattern);
+        //Assert
+        std::vector<size_t> modelResult = findAll(frankenstein_fulltext, pattern);
+        ASSERT_EQ(result, modelResult) << pattern;
+        ASSERT_EQ(index.count(pattern), modelResult.size());
+        ASSERT_EQ(index.contains(pattern), !modelResult.empty());
+    }
+}
+
+TEST(SuffixArray, longest_repeated_substring)
+{
+    //Arrange
+    std::string text = "to be or not to be, that is the question";
+    //Act
+    SuffixArray index(text);
+    //Assert
+    EXPECT_EQ(index.longestRepeatedSubstring(), "to be");
+    ASSERT_EQ(SuffixArray(std::string_view("abc")).longestRepeatedSubstring(), "");
+}
+
+
+/*** FMIndex ***/
+TEST(FMIndex, count_and_locate_in_banana)
+{
+    //Arrange
+    std::string text = "banana";
+    //Act
+    FMIndex index(text, 2);
+    //Assert
+    EXPECT_EQ(index.count("ana"), 2);
+    EXPECT_EQ(index.count("a"), 3);
+    EXPECT_EQ(index.count(""), 7);
+    EXPECT_FALSE(index.contains("nab"));
+    EXPECT_EQ(index.locate("ana"), std::vector<size_t>({1, 3}));
+    ASSERT_EQ(index.locate("banana"), std::vector<size_t>({0}));
+}
+
+TEST(FMIndex, matches_findAll)
+{
+    //Arrange
+    FMIndex index(frankenstein_fulltext, 16);
+    std::vector<std::string> patterns = {"Victor", "the", "Elizabeth", "monster", "zzz", "e", "\n\n", "I "};
+    for(const std::string & pattern : patterns)
+    {
+        //Act
+        std::vector<size_t> result = index.locate(pattern);
+        //Assert
+        std::vector<size_t> modelResult = findAll(frankenstein_fulltext, pattern);
+        ASSERT_EQ(result, modelResult) << pattern;
+        ASSERT_EQ(index.count(pattern), modelResult.size());
+    }
+}
+
+TEST(FMIndex, binary_text)
+{
+    //Arrange
+    std::string text;
+    for(int i = 0; i < 2000; i++)
+    {
+        text += static_cast<char>((i * 37) % 256);
+        text += '\0';
+    }
+    std::string pattern("\0\x25", 2);
+    //Act
+    FMIndex index(text, 7);
+    //Assert
+    ASSERT_EQ(index.locate(pattern), findAll(text, pattern));
+}
+
+TEST(FMIndex, save_and_load)
+{
+    //Arrange
+    std::string filePath = (std::filesystem::temp_directory_path() / "stevensStringLib_FMIndex_test.bin").string();
+    FMIndex(frankenstein_fulltext).save(filePath);
+    //Act
+    FMIndex index = FMIndex::load(filePath);
+    //Assert
+    EXPECT_EQ(index.size(), frankenstein_fulltext.size());
+    EXPECT_EQ(index.locate("Frankenstein"), findAll(frankenstein_fulltext, "Frankenstein"));
+    std::filesystem::remove(filePath);
+}
+
+TEST(FMIndex, load_invalid_file_throws)
+{
+    //Arrange
+    std::string filePath = "test_string_files/frankenstein.txt";
+    //Act & Assert
+    ASSERT_THROW(FMIndex::load(filePath), std::invalid_argument);
+}
+
+
+/*** findApproximate ***/
+TEST(findApproximate, exact_matches_are_findAll)
+{
+    //Arrange
+    std::string pattern = "Elizabeth";
+    //Act
+    std::vector<ApproximateMatch> result = findApproximate(frankenstein_fulltext, pattern, 0);
+    //Assert
+    std::vector<size_t> modelResult = findAll(frankenstein_fulltext, pattern);
+    ASSERT_EQ(result.size(), modelResult.size());
+    for(size_t i = 0; i < result.size(); i++)
+    {
+        ASSERT_EQ(result[i].end, modelResult[i] + pattern.size());
+        ASSERT_EQ(result[i].distance, 0);
+    }
+}
+
+TEST(findApproximate, one_typo)
+{
+    //Arrange
+    std::string str = "the quick brwn fox";
+    //Act
+    std::vector<ApproximateMatch> result = findApproximate(str, "brown", 1);
+    //Assert
+    std::vector<ApproximateMatch> modelResult = {{14, 1}};
+    ASSERT_EQ(result, modelResult);
+}
+
+TEST(findApproximate, long_pattern)
+{
+    //Arrange
+    std::string pattern = frankenstein_fulltext.substr(100000, 150);
+    pattern[10] = '#';
+    pattern.erase(90, 1);
+    //Act
+    std::vector<ApproximateMatch> result = findApproximate(frankenstein_fulltext, pattern, 2);
+    //Assert
+    ASSERT_FALSE(result.empty());
+    ASSERT_EQ(std::min_element(result.begin(), result.end(), [](auto a, auto b) { return a.distance < b.distance; })->end, 100150);
+}
+
+TEST(findApproximate, empty_substring_at_the_start)
+{
+    //Arrange
+    std::string str = "a";
+    //Act
+    std::vector<ApproximateMatch> result = findApproximate(str, "b", 1);
+    //Assert
+    ASSERT_EQ(result, (std::vector<ApproximateMatch>{{0, 1}, {1, 1}}));
+}
+
+/*** containsApproximate ***/
+TEST(containsApproximate, within_and_beyond_distance)
+{
+    //Arrange
+    std::string str = "connection refused by host";
+    //Act & Assert
+    EXPECT_TRUE(containsApproximate(str, "refsued", 2));
+    EXPECT_FALSE(containsApproximate(str, "refsued", 1));
+    EXPECT_TRUE(containsApproximate(str, "", 0));
+    ASSERT_FALSE(containsApproximate("", "a", 0));
+}
+
+/*** bestApproximateMatch ***/
+TEST(bestApproximateMatch, closest_substring)
+{
+    //Arrange
+    std::string str = "colour, color, colr";
+    //Act
+    ApproximateMatch result = bestApproximateMatch(str, "color");
+    //Assert
+    ASSERT_EQ(result, (ApproximateMatch{13, 0}));
+}
+
+TEST(bestApproximateMatch, no_common_characters)
+{
+    //Arrange
+    std::string str = "xyz";
+    //Act
+    ApproximateMatch result = bestApproximateMatch(str, "ab");
+    //Assert
+    ASSERT_EQ(result, (ApproximateMatch{0, 2}));
+}
+
+
+/*** levenshteinDistance ***/
+TEST(levenshteinDistance, kitten_sitting)
+{
+    //Arrange
+    std::string str1 = "kitten";
+    std::string str2 = "sitting";
+    //Act & Assert
+    EXPECT_EQ(levenshteinDistance(str1, str2), 3);
+    EXPECT_EQ(levenshteinDistance(str2, str1), 3);
+    EXPECT_EQ(levenshteinDistance("", str2), 7);
+    ASSERT_EQ(levenshteinDistance(str1, str1), 0);
+}
+
+TEST(levenshteinDistance, threshold)
+{
+    //Arrange
+    std::string str1 = "kitten";
+    std::string str2 = "sitting";
+    //Act & Assert
+    EXPECT_EQ(levenshteinDistance(str1, str2, 3), 3);
+    EXPECT_EQ(levenshteinDistance(str1, str2, 2), 3);
+    ASSERT_EQ(levenshteinDistance("a", "abcdef", 1), 2);
+}
+
+TEST(levenshteinDistance, long_strings)
+{
+    //Arrange
+    std::string str1 = frankenstein_fulltext.substr(5000, 300);
+    std::string str2 = str1;
+    str2.erase(10, 5);
+    str2[200] = '#';
+    str2.insert(250, "xyz");
+    //Act
+    size_t result = levenshteinDistance(str1, str2);
+    //Assert
+    ASSERT_EQ(result, 9);
+}
+
+/*** damerauLevenshteinDistance ***/
+TEST(damerauLevenshteinDistance, transpositions)
+{
+    //Act & Assert
+    EXPECT_EQ(damerauLevenshteinDistance("ca", "ac"), 1);
+    EXPECT_EQ(levenshteinDistance("ca", "ac"), 2);
+    EXPECT_EQ(damerauLevenshteinDistance("ca", "abc"), 3);
+    EXPECT_EQ(damerauLevenshteinDistance("recieve", "receive"), 1);
+    ASSERT_EQ(damerauLevenshteinDistance("recieve", "deceit", 1), 2);
+}
+
+/*** jaroSimilarity ***/
+TEST(jaroSimilarity, known_values)
+{
+    //Act & Assert
+    EXPECT_NEAR(jaroSimilarity("MARTHA", "MARHTA"), 0.944444, 1e-6);
+    EXPECT_NEAR(jaroSimilarity("CRATE", "TRACE"), 0.733333, 1e-6);
+    EXPECT_EQ(jaroSimilarity("", ""), 1.0);
+    ASSERT_EQ(jaroSimilarity("abc", "xyz"), 0.0);
+}
+
+/*** jaroWinklerSimilarity ***/
+TEST(jaroWinklerSimilarity, known_values)
+{
+    //Act & Assert
+    EXPECT_NEAR(jaroWinklerSimilarity("MARTHA", "MARHTA"), 0.961111, 1e-6);
+    EXPECT_NEAR(jaroWinklerSimilarity("DIXON", "DICKSONX"), 0.813333, 1e-6);
+    ASSERT_THROW(jaroWinklerSimilarity("a", "b", 0.5), std::invalid_argument);
+}
+
+/*** longestCommonSubsequenceLength ***/
+TEST(longestCommonSubsequenceLength, short_and_long_strings)
+{
+    //Arrange
+    std::string str1 = frankenstein_fulltext.substr(0, 200);
+    std::string str2 = str1;
+    str2.erase(std::remove(str2.begin(), str2.end(), 'e'), str2.end());
+    //Act & Assert
+    EXPECT_EQ(longestCommonSubsequenceLength("ABCBDAB", "BDCABA"), 4);
+    EXPECT_EQ(longestCommonSubsequenceLength("", "abc"), 0);
+    ASSERT_EQ(longestCommonSubsequenceLength(str1, str2), str2.size());
+}
+
+/*** findSimilar ***/
+TEST(findSimilar, candidates_within_distance)
+{
+    //Arrange
+    std::vector<std::string> candidates = {"Frankenstein", "Frankenstien", "Frankfurt", "frankenstein", "Franken"};
+    //Act
+    std::vector<SimilarCandidate> result = findSimilar("Frankenstein", candidates, 2);
+    //Assert
+    std::vector<SimilarCandidate> modelResult = {{0, 0}, {1, 2}, {3, 1}};
+    EXPECT_EQ(result, modelResult);
+    ASSERT_EQ(LevenshteinMatcher("Frankenstein").distance("Franken"), 5);
+}
+
+
+/*** Glob ***/
+TEST(Glob, stars_and_question_marks)
+{
+    //Arrange
+    Glob glob("/api/*/users/?");
+    //Act & Assert
+    EXPECT_TRUE(glob.matches("/api/v1/users/7"));
+    EXPECT_FALSE(glob.matches("/api/v1/extra/users/7"));
+    EXPECT_FALSE(glob.matches("/api/v1/users/42"));
+    EXPECT_FALSE(glob.matches("/api/v1/users/"));
+    ASSERT_EQ(glob.literalPrefix(), "/api/");
+}
+
+TEST(Glob, globstar)
+{
+    //Arrange
+    Glob glob("/static/**/*.css");
+    //Act & Assert
+    EXPECT_TRUE(glob.matches("/static/site.css"));
+    EXPECT_TRUE(glob.matches("/static/themes/dark/site.css"));
+    EXPECT_FALSE(glob.matches("/static/themes/site.js"));
+    EXPECT_TRUE(globMatch("**/*.txt", "notes.txt"));
+    EXPECT_TRUE(globMatch("**/*.txt", "a/b/notes.txt"));
+    EXPECT_TRUE(globMatch("logs/**", "logs/2024/01/app.log"));
+    ASSERT_FALSE(globMatch("logs/a**", "logs/a/b"));
+}
+
+TEST(Glob, character_classes_and_escapes)
+{
+    //Act & Assert
+    EXPECT_TRUE(globMatch("file[0-9].txt", "file7.txt"));
+    EXPECT_FALSE(globMatch("file[!0-9].txt", "file7.txt"));
+    EXPECT_TRUE(globMatch("file[^0-9].txt", "fileA.txt"));
+    EXPECT_FALSE(globMatch("a[!x]b", "a/b"));
+    EXPECT_TRUE(globMatch("[]]", "]"));
+    EXPECT_TRUE(globMatch("what\\?", "what?"));
+    EXPECT_FALSE(globMatch("what\\?", "whats"));
+    ASSERT_THROW(Glob("file[0-9"), std::invalid_argument);
+}
+
+TEST(Glob, backtracking)
+{
+    //Act & Assert
+    EXPECT_TRUE(globMatch("*a*b*c", "xxaxxbxxaxbxxc"));
+    EXPECT_FALSE(globMatch("*a*b*c", "xxaxxbxxaxbxx"));
+    EXPECT_TRUE(globMatch("**/x*/y", "a/x1/b/x2/y"));
+    EXPECT_TRUE(globMatch("", ""));
+    ASSERT_FALSE(globMatch("", "a"));
+}
+
+/*** GlobSet ***/
+TEST(GlobSet, matching_patterns)
+{
+    //Arrange
+    std::vector<std::string> patterns = {"/api/*/users/**", "/api/v1/*", "/static/**", "/api/v1/users/*", "*"};
+    GlobSet set(patterns);
+    //Act & Assert
+    EXPECT_EQ(set.matchingPatterns("/api/v1/users/7"), std::vector<size_t>({0, 3}));
+    EXPECT_EQ(set.matchingPatterns("/api/v1/users"), std::vector<size_t>({1}));
+    EXPECT_EQ(set.matchingPatterns("index.html"), std::vector<size_t>({4}));
+    EXPECT_TRUE(set.matches("/static/app.js"));
+    ASSERT_FALSE(set.matches("/other/page"));
+}
+
+
+/*** Regex ***/
+TEST(Regex, matches)
+{
+    //Arrange
+    Regex regex("[a-z]+@[a-z]+\\.(com|org)");
+    //Act & Assert
+    EXPECT_TRUE(regex.matches("mary@shelley.org"));
+    EXPECT_FALSE(regex.matches("mary@shelley.net"));
+    EXPECT_FALSE(regex.matches("Mary@shelley.com"));
+    EXPECT_TRUE(Regex("\\d{3}-\\d{4}").matches("555-1234"));
+    EXPECT_FALSE(Regex("\\d{3}-\\d{4}").matches("555-12345"));
+    ASSERT_TRUE(Regex("").matches(""));
+}
+
+TEST(Regex, search_is_leftmost_longest)
+{
+    //Arrange
+    Regex regex("a|ab|abc");
+    //Act
+    std::optional<RegexMatch> result = regex.search("xxabcd");
+    //Assert
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(*result, (RegexMatch{2, 3}));
+    EXPECT_EQ(Regex("b+").search("aabbbc"), (RegexMatch{2, 3}));
+    EXPECT_EQ(Regex("x*").search("abc"), (RegexMatch{0, 0}));
+    ASSERT_FALSE(Regex("z").search("abc").has_value());
+}
+
+TEST(Regex, anchors)
+{
+    //Act & Assert
+    EXPECT_EQ(Regex("^ab").search("abab"), (RegexMatch{0, 2}));
+    EXPECT_FALSE(Regex("^b").search("abab").has_value());
+    EXPECT_EQ(Regex("ab$").search("abab"), (RegexMatch{2, 2}));
+    EXPECT_EQ(Regex("^ab$").findAll("ab").size(), 1);
+    ASSERT_EQ(Regex("^a").findAll("aaa").size(), 1);
+}
+
+TEST(Regex, anchors_around_alternation)
+{
+    //Act & Assert
+    EXPECT_THROW(Regex("^a|b"), std::invalid_argument);
+    EXPECT_THROW(Regex("a|b$"), std::invalid_argument);
+    EXPECT_EQ(Regex("^(a|b)").search("xb"), std::nullopt);
+    EXPECT_EQ(Regex("(a|b)$").search("ax"), std::nullopt);
+    EXPECT_EQ(Regex("^(a|b)").search("bx"), (RegexMatch{0, 1}));
+    ASSERT_EQ(Regex("(?:a|b)$").search("xa"), (RegexMatch{1, 1}));
+}
+
+TEST(Regex, findAll_matches_findAll_for_literals)
+{
+    //Arrange
+    Regex regex("Frankenstein");
+    //Act
+    std::vector<RegexMatch> result = regex.findAll(frankenstein_fulltext);
+    //Assert
+    std::vector<size_t> modelResult = findAll(frankenstein_fulltext, "Frankenstein");
+    ASSERT_EQ(result.size(), modelResult.size());
+    for(size_t i = 0; i < result.size(); i++)
+    {
+        ASSERT_EQ(result[i], (RegexMatch{modelResult[i], 12}));
+    }
+}
+
+TEST(Regex, findAll_numbers_and_words)
+{
+    //Arrange
+    std::string str = "Chapter 12, page 345; 6 letters";
+    //Act
+    std::vector<RegexMatch> numbers = Regex("[0-9]+").findAll(str);
+    std::vector<RegexMatch> empties = Regex("[0-9]*").findAll("a1");
+    //Assert
+    EXPECT_EQ(numbers, std::vector<RegexMatch>({{8, 2}, {17, 3}, {22, 1}}));
+    ASSERT_EQ(empties, std::vector<RegexMatch>({{0, 0}, {1, 1}, {2, 0}}));
+}
+
+TEST(Regex, linear_on_pathological_patterns)
+{
+    //Arrange
+    std::string str(100000, 'a');
+    //Act & Assert
+    EXPECT_FALSE(Regex("(a*)*b").matches(str));
+    EXPECT_FALSE(Regex("(a|aa)+b").search(str).has_value());
+    ASSERT_TRUE(Regex("(a|aa)+", 16).matches(str));
+}
+
+TEST(Regex, invalid_patterns_throw)
+{
+    //Act & Assert
+    EXPECT_THROW(Regex("(ab"), std::invalid_argument);
+    EXPECT_THROW(Regex("ab)"), std::invalid_argument);
+    EXPECT_THROW(Regex("[ab"), std::invalid_argument);
+    EXPECT_THROW(Regex("*a"), std::invalid_argument);
+    EXPECT_THROW(Regex("a*?"), std::invalid_argument);
+    EXPECT_THROW(Regex("(a)\\1"), std::invalid_argument);
+    EXPECT_THROW(Regex("a^b"), std::invalid_argument);
+    ASSERT_THROW(Regex("a{3,2}"), std::invalid_argument);
+}
+
+TEST(Regex, repetition_counts_are_bounded)
+{
+    //Act & Assert
+    EXPECT_THROW(Regex("a{10010}"), std::invalid_argument);
+    EXPECT_THROW(Regex("a{1001,}"), std::invalid_argument);
+    EXPECT_THROW(Regex("a{0,1001}"), std::invalid_argument);
+    EXPECT_THROW(Regex("a{99999999999999999999999}"), std::invalid_argument);
+    EXPECT_TRUE(Regex("a{1000}").matches(std::string(1000, 'a')));
+    EXPECT_TRUE(Regex("a{2,}").matches("aaaa"));
+    ASSERT_TRUE(Regex("a{1,10010").matches("a{1,10010"));
+}
+
+TEST(Regex, nesting_depth_is_bounded)
+{
+    //Arrange
+    std::string deepGroups = std::string(100000, '(') + "a" + std::string(100000, ')');
+    std::string deepRepetitions = "a" + std::string(100000, '?');
+    std::string shallowGroups = std::string(100, '(') + "a" + std::string(100, ')');
+    //Act & Assert
+    EXPECT_THROW(Regex(std::string(100000, '(')), std::invalid_argument);
+    EXPECT_THROW(Regex{deepGroups}, std::invalid_argument);
+    EXPECT_THROW(Regex{deepRepetitions}, std::invalid_argument);
+    ASSERT_TRUE(Regex(shallowGroups).matches("a"));
+}
+
+
 
 
 int main(   int argc,